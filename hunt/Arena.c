@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// Arena.c: a bump allocator for short-lived arrays
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Arena.h"
+
+// Every allocation is rounded up to this, so each one is aligned for
+// any type
+#define ALIGNMENT (_Alignof(max_align_t))
+
+typedef struct block {
+	struct block *next; // the block that filled up before this one
+	size_t        size; // bytes in data
+	size_t        used;
+	_Alignas(max_align_t) unsigned char data[];
+} Block;
+
+struct arena {
+	Block *blocks;    // the block being allocated from, then the full ones
+	size_t numBytes;  // allocated since the last reset
+};
+
+static __thread Arena current = NULL;
+
+static Block *newBlock(size_t size, Block *next);
+
+////////////////////////////////////////////////////////////////////////
+
+Arena ArenaNew(size_t blockSize)
+{
+	Arena arena = malloc(sizeof(*arena));
+	if (arena == NULL) {
+		fprintf(stderr, "Couldn't allocate Arena!\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	arena->blocks = newBlock(blockSize, NULL);
+	arena->numBytes = 0;
+	return arena;
+}
+
+void ArenaFree(Arena arena)
+{
+	if (arena == NULL) return;
+	if (current == arena) current = NULL;
+	
+	for (Block *b = arena->blocks, *next; b != NULL; b = next) {
+		next = b->next;
+		free(b);
+	}
+	free(arena);
+}
+
+void *ArenaAlloc(Arena arena, size_t size)
+{
+	size = (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+	Block *b = arena->blocks;
+	if (b->size - b->used < size) {
+		size_t blockSize = (b->size * 2 > size) ? b->size * 2 : size;
+		b = arena->blocks = newBlock(blockSize, b);
+	}
+	
+	void *p = &b->data[b->used];
+	b->used += size;
+	arena->numBytes += size;
+	return p;
+}
+
+void ArenaReset(Arena arena)
+{
+	Block *b = arena->blocks;
+	if (b->next != NULL) {
+		// Replace the blocks with one that would have held everything
+		size_t total = 0;
+		for (Block *next; b != NULL; b = next) {
+			next = b->next;
+			total += b->size;
+			free(b);
+		}
+		arena->blocks = newBlock(total, NULL);
+	}
+	
+	arena->blocks->used = 0;
+	arena->numBytes = 0;
+}
+
+size_t ArenaBytesUsed(Arena arena)
+{
+	return arena->numBytes;
+}
+
+Arena ArenaUse(Arena arena)
+{
+	Arena previous = current;
+	current = arena;
+	return previous;
+}
+
+void *ArenaAllocResult(size_t size)
+{
+	if (current != NULL) {
+		return ArenaAlloc(current, size);
+	}
+	
+	void *p = malloc(size);
+	if (p == NULL && size > 0) {
+		fprintf(stderr, "Couldn't allocate view result!\n");
+		exit(EXIT_FAILURE);
+	}
+	return p;
+}
+
+////////////////////////////////////////////////////////////////////////
+
+static Block *newBlock(size_t size, Block *next) {
+	assert(size > 0);
+	Block *b = malloc(sizeof(*b) + size);
+	if (b == NULL) {
+		fprintf(stderr, "Couldn't allocate Arena!\n");
+		exit(EXIT_FAILURE);
+	}
+	b->next = next;
+	b->size = size;
+	b->used = 0;
+	return b;
+}
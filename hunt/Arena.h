@@ -0,0 +1,56 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// Arena.h: a bump allocator for short-lived arrays
+//
+// An arena hands out memory by moving a pointer along a block, and
+// gets it all back at once when it is reset, so there is nothing to
+// free one array at a time. When a block fills up another is added,
+// and a reset merges them into one block big enough for the lot, so an
+// arena soon stops asking malloc for anything.
+//
+// Each thread can have an arena in use. While it does, the arrays the
+// views return (GvGetReachable, DvGetValidMoves, HvGetShortestPathTo
+// and so on) come from that arena rather than from malloc: they belong
+// to the arena, must NOT be freed, and last until it is reset. The AIs
+// use one for each decision (see decisionArena).
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <stddef.h>
+
+#ifndef FOD__ARENA_H_
+#define FOD__ARENA_H_
+
+typedef struct arena *Arena;
+
+/** Creates an empty arena whose first block holds blockSize bytes. */
+Arena ArenaNew(size_t blockSize);
+
+/** Frees all memory allocated for the given arena. */
+void ArenaFree(Arena arena);
+
+/**
+ * Allocates `size` bytes from the arena, aligned for any type. They
+ * stay allocated until the arena is reset.
+ */
+void *ArenaAlloc(Arena arena, size_t size);
+
+/** Gives back everything allocated from the arena, all at once. */
+void ArenaReset(Arena arena);
+
+/** How many bytes have been allocated since the last reset. */
+size_t ArenaBytesUsed(Arena arena);
+
+/**
+ * Makes `arena` the calling thread's arena in use (NULL for none), and
+ * returns the one that was in use before, to put back afterwards.
+ */
+Arena ArenaUse(Arena arena);
+
+/**
+ * Allocates an array for a view to return: from the calling thread's
+ * arena in use if it has one, otherwise with malloc.
+ */
+void *ArenaAllocResult(size_t size);
+
+#endif // !defined(FOD__ARENA_H_)
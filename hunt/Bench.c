@@ -0,0 +1,280 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// Bench.c: timing operations on real game states
+//
+////////////////////////////////////////////////////////////////////////
+
+#define _GNU_SOURCE
+
+#include <assert.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Bench.h"
+#include "Game.h"
+#include "Replay.h"
+
+#define DEFAULT_BENCH_MSECS 200
+#define MAX_SAMPLES         (1 << 20)
+
+// How long a sample's batch of calls should take, and the most calls
+// in one
+#define BATCH_NSECS         1000.0
+#define MAX_BATCH           1024
+
+static int benchMsecs = DEFAULT_BENCH_MSECS;
+static long numAllocs = 0;
+static long numBytes = 0;
+
+static void initBench(void) __attribute__((constructor));
+static bool isPastPlays(const char *line);
+static void addState(BenchState **states, int *numStates, int *maxStates,
+                     const char *pastPlays);
+static int compareDoubles(const void *a, const void *b);
+
+static void initBench(void) {
+	const char *value = getenv("FOD_BENCH_MSECS");
+	if (value != NULL && atoi(value) > 0) benchMsecs = atoi(value);
+}
+
+////////////////////////////////////////////////////////////////////////
+// Counting allocations
+//
+// These take the place of the C library's own, which they call, so
+// every allocation the program makes is counted, even those made
+// inside the library (e.g. by strdup).
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t num, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+void *malloc(size_t size) {
+	__atomic_add_fetch(&numAllocs, 1, __ATOMIC_RELAXED);
+	__atomic_add_fetch(&numBytes, size, __ATOMIC_RELAXED);
+	return __libc_malloc(size);
+}
+
+void *calloc(size_t num, size_t size) {
+	__atomic_add_fetch(&numAllocs, 1, __ATOMIC_RELAXED);
+	__atomic_add_fetch(&numBytes, num * size, __ATOMIC_RELAXED);
+	return __libc_calloc(num, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+	__atomic_add_fetch(&numAllocs, 1, __ATOMIC_RELAXED);
+	__atomic_add_fetch(&numBytes, size, __ATOMIC_RELAXED);
+	return __libc_realloc(ptr, size);
+}
+
+long benchNumAllocs(void)
+{
+	return __atomic_load_n(&numAllocs, __ATOMIC_RELAXED);
+}
+
+long benchNumBytes(void)
+{
+	return __atomic_load_n(&numBytes, __ATOMIC_RELAXED);
+}
+
+////////////////////////////////////////////////////////////////////////
+// States
+
+BenchState *benchLoadStates(const char *pastPlaysFile,
+                            const char *replayFile, int *numStates)
+{
+	BenchState *states = NULL;
+	int maxStates = 0;
+	*numStates = 0;
+	
+	if (pastPlaysFile != NULL) {
+		FILE *in = fopen(pastPlaysFile, "r");
+		if (in == NULL) {
+			fprintf(stderr, "Couldn't open '%s'\n", pastPlaysFile);
+			exit(EXIT_FAILURE);
+		}
+		
+		char *line = NULL;
+		size_t size = 0;
+		while (getline(&line, &size, in) != -1) {
+			// Some of them have a space at the end
+			int length = strcspn(line, "\r\n");
+			while (length > 0 && line[length - 1] == ' ') length--;
+			line[length] = '\0';
+			if (isPastPlays(line)) {
+				addState(&states, numStates, &maxStates, line);
+			}
+		}
+		free(line);
+		fclose(in);
+	}
+	
+	if (replayFile != NULL) {
+		Replay rp = ReplayOpen(replayFile);
+		if (rp == NULL) {
+			fprintf(stderr, "Couldn't read '%s' (try make corpus.replay)\n",
+			        replayFile);
+			exit(EXIT_FAILURE);
+		}
+		
+		for (int game = 0; game < ReplayNumGames(rp); game++) {
+			int numPlays = ReplayNumPlays(rp, game);
+			char *pastPlays = malloc(numPlays * REPLAY_RECORD_SIZE + 1);
+			if (pastPlays == NULL) {
+				fprintf(stderr, "Couldn't allocate pastPlays\n");
+				exit(EXIT_FAILURE);
+			}
+			for (int play = 0; play < numPlays; play++) {
+				ReplayGetPastPlays(rp, game, play, pastPlays);
+				addState(&states, numStates, &maxStates, pastPlays);
+			}
+			free(pastPlays);
+		}
+		ReplayClose(rp);
+	}
+	
+	return states;
+}
+
+void benchFreeStates(BenchState *states, int numStates)
+{
+	for (int i = 0; i < numStates; i++) {
+		free(states[i].pastPlays);
+	}
+	free(states);
+}
+
+/**
+ * Whether a line is a whole pastPlays string: plays of 7 characters,
+ * separated by spaces
+ */
+static bool isPastPlays(const char *line) {
+	int length = strlen(line);
+	if (length == 0 || (length + 1) % 8 != 0) return false;
+	
+	for (int i = 0; i < length; i += 8) {
+		if (strchr("GSHMD", line[i]) == NULL) return false;
+		if (i + 7 < length && line[i + 7] != ' ') return false;
+	}
+	return true;
+}
+
+static void addState(BenchState **states, int *numStates, int *maxStates,
+                     const char *pastPlays) {
+	if (*numStates == *maxStates) {
+		*maxStates = (*maxStates == 0) ? 256 : *maxStates * 2;
+		*states = realloc(*states, *maxStates * sizeof(BenchState));
+		if (*states == NULL) {
+			fprintf(stderr, "Couldn't allocate states\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	
+	int numPlays = (strlen(pastPlays) + 1) / 8;
+	BenchState *state = &(*states)[(*numStates)++];
+	state->pastPlays = strdup(pastPlays);
+	if (state->pastPlays == NULL) {
+		fprintf(stderr, "Couldn't allocate state\n");
+		exit(EXIT_FAILURE);
+	}
+	state->player = numPlays % NUM_PLAYERS;
+	state->round = numPlays / NUM_PLAYERS;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Timing
+
+void benchShowHeader(void)
+{
+	printf("%-32s %10s %10s %10s %10s %10s %10s %10s %10s\n", "benchmark",
+	       "calls", "ns/op", "allocs/op", "bytes/op", "p50", "p90", "p99",
+	       "max");
+}
+
+void benchRun(const char *name, BenchOp op, void *arg, int numStates)
+{
+	BenchResult r;
+	benchMeasure(op, arg, numStates, &r);
+	printf("%-32s %10ld %10.1f %10.2f %10.0f %10.1f %10.1f %10.1f %10.1f\n",
+	       name, r.numCalls, r.nsecsPerOp, r.allocsPerOp, r.bytesPerOp,
+	       r.p50, r.p90, r.p99, r.max);
+	fflush(stdout);
+}
+
+void benchMeasure(BenchOp op, void *arg, int numStates, BenchResult *r)
+{
+	assert(numStates > 0);
+	
+	double *samples = malloc(MAX_SAMPLES * sizeof(double));
+	if (samples == NULL) {
+		fprintf(stderr, "Couldn't allocate samples\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	// Warm up, and see how many calls a batch needs
+	int numWarmups = (numStates < 100) ? numStates : 100;
+	double start = benchNowNsecs();
+	for (int i = 0; i < numWarmups; i++) {
+		op(arg, i);
+	}
+	double warmupNsecs = (benchNowNsecs() - start) / numWarmups;
+	int batch = (int) ceil(BATCH_NSECS / fmax(warmupNsecs, 1.0));
+	if (batch > MAX_BATCH) batch = MAX_BATCH;
+	
+	// Go through every state at least once, and until time's up
+	long numCalls = 0;
+	int numSamples = 0;
+	double totalNsecs = 0.0;
+	long allocsBefore = benchNumAllocs();
+	long bytesBefore = benchNumBytes();
+	double deadline = benchNowNsecs() + benchMsecs * 1e6;
+	for (int i = 0; numSamples < MAX_SAMPLES; i = (i + 1) % numStates) {
+		double before = benchNowNsecs();
+		for (int j = 0; j < batch; j++) {
+			op(arg, i);
+		}
+		double nsecs = benchNowNsecs() - before;
+		
+		samples[numSamples++] = nsecs / batch;
+		totalNsecs += nsecs;
+		numCalls += batch;
+		if (numSamples >= numStates && benchNowNsecs() >= deadline) break;
+	}
+	long numOpAllocs = benchNumAllocs() - allocsBefore;
+	long numOpBytes = benchNumBytes() - bytesBefore;
+	
+	r->numCalls = numCalls;
+	r->nsecsPerOp = totalNsecs / numCalls;
+	r->allocsPerOp = (double) numOpAllocs / numCalls;
+	r->bytesPerOp = (double) numOpBytes / numCalls;
+	r->p50 = benchPercentile(samples, numSamples, 50);
+	r->p90 = benchPercentile(samples, numSamples, 90);
+	r->p99 = benchPercentile(samples, numSamples, 99);
+	r->max = benchPercentile(samples, numSamples, 100);
+	free(samples);
+}
+
+double benchNowNsecs(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+double benchPercentile(double samples[], int numSamples, double p)
+{
+	assert(numSamples > 0);
+	qsort(samples, numSamples, sizeof(double), compareDoubles);
+	int i = (int) ceil(p / 100 * numSamples) - 1;
+	if (i < 0) i = 0;
+	return samples[i];
+}
+
+static int compareDoubles(const void *a, const void *b) {
+	double x = *(const double *) a;
+	double y = *(const double *) b;
+	return (x > y) - (x < y);
+}
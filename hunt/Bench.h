@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// Bench.h: timing operations on real game states
+//
+// A benchmark runs one operation over and over, on each of a set of
+// game states in turn, until its time is up. Each sample times a batch
+// of calls on one state (enough calls to take about a microsecond, so
+// that reading the clock doesn't swamp a fast operation), and the
+// report gives the mean time per call, the 50th, 90th and 99th
+// percentiles and the worst of the samples, and how many times the
+// operation called malloc, calloc or realloc per call and how many
+// bytes it asked them for. Any program linked with Bench.o counts its
+// allocations.
+//
+// The states come from pastPlays.txt, and from replay files made from
+// recorded games (see corpus.c and Replay.h).
+//
+// The time per benchmark is read from the environment when the program
+// starts:
+//     FOD_BENCH_MSECS  how long to run each benchmark for (200)
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+
+#include "Game.h"
+
+#ifndef FOD__BENCH_H_
+#define FOD__BENCH_H_
+
+/** A game state: the pastPlays string given to the player whose turn
+ *  it is */
+typedef struct benchState {
+	char  *pastPlays;
+	Player player;
+	Round  round;
+} BenchState;
+
+/** What benchMeasure found: times are in nanoseconds per call */
+typedef struct benchResult {
+	long   numCalls;
+	double nsecsPerOp;
+	double allocsPerOp;
+	double bytesPerOp;
+	double p50;
+	double p90;
+	double p99;
+	double max;
+} BenchResult;
+
+/**
+ * An operation to time. Should do its work on the i'th state (whatever
+ * that means for the operation), and free anything it allocates.
+ */
+typedef void (*BenchOp)(void *arg, int i);
+
+/**
+ * Reads every state in a file of pastPlays strings like pastPlays.txt
+ * (one per line, among other text), and every turn of every game in a
+ * replay file. Either file can be NULL. Sets *numStates to how many
+ * there were.
+ */
+BenchState *benchLoadStates(const char *pastPlaysFile,
+                            const char *replayFile, int *numStates);
+
+/** Frees the states benchLoadStates returned. */
+void benchFreeStates(BenchState *states, int numStates);
+
+/** Prints the column headings for benchRun's reports. */
+void benchShowHeader(void);
+
+/**
+ * Times `op` on states 0 to numStates - 1 in turn, and prints a report
+ * under the given name.
+ */
+void benchRun(const char *name, BenchOp op, void *arg, int numStates);
+
+/** Like benchRun, but fills in *result instead of printing a report. */
+void benchMeasure(BenchOp op, void *arg, int numStates,
+                  BenchResult *result);
+
+/** The number of allocations the program has made so far. */
+long benchNumAllocs(void);
+
+/** The number of bytes those allocations asked for. */
+long benchNumBytes(void);
+
+/** A monotonic clock, in nanoseconds. */
+double benchNowNsecs(void);
+
+/**
+ * The p'th percentile (0 to 100) of the given samples, which it sorts.
+ */
+double benchPercentile(double samples[], int numSamples, double p);
+
+#endif // !defined(FOD__BENCH_H_)
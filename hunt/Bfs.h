@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// Bfs.h: breadth-first search over the places, without the heap
+//
+// The caller says where each place leads with a function that returns
+// the next places as a PlaceSet. It also gets how many steps the search
+// took to get there, so the moves can depend on the round (e.g. a
+// hunter's rail range). There are two searches:
+// - bfsSearch visits places one at a time from a queue, and records
+//   how far away each one is and the place it was reached from. No
+//   place is queued twice, so the queue is a fixed array of
+//   NUM_REAL_PLACES on the stack.
+// - bfsWithin works a whole layer at a time on PlaceSets, and only
+//   says which places were reached.
+// Neither one allocates anything. The caller provides the dist and pred
+// arrays, or passes NULL to use this thread's scratch array for dist
+// and skip pred.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <stddef.h>
+
+#include "PlaceSet.h"
+#include "Places.h"
+
+#ifndef FOD__BFS_H_
+#define FOD__BFS_H_
+
+// For maxDepth: search as far as the places go
+#define BFS_NO_LIMIT -1
+
+/**
+ * The places one step on from p, which the search reached in `depth`
+ * steps. `arg` is passed on from the search.
+ */
+typedef PlaceSet (*BfsNeighbours)(PlaceId p, int depth, void *arg);
+
+/**
+ * Searches out from src, at most maxDepth steps (or BFS_NO_LIMIT).
+ * Sets dist[p] to the number of steps to p, or -1 if it wasn't
+ * reached. Sets pred[p] to the place p was first reached from (src for
+ * src itself), or NOWHERE. Places are taken off the queue in the order
+ * they were reached, and each one's neighbours are added in increasing
+ * order, so ties always go the same way. Returns how many places were
+ * reached, including src.
+ */
+static inline int bfsSearch(PlaceId src, int maxDepth,
+                            BfsNeighbours neighbours, void *arg,
+                            int dist[NUM_REAL_PLACES],
+                            PlaceId pred[NUM_REAL_PLACES])
+{
+	static __thread int scratch[NUM_REAL_PLACES];
+	if (dist == NULL) dist = scratch;
+	for (int i = 0; i < NUM_REAL_PLACES; i++) {
+		dist[i] = -1;
+		if (pred != NULL) pred[i] = NOWHERE;
+	}
+	
+	PlaceId queue[NUM_REAL_PLACES];
+	int head = 0, tail = 0;
+	queue[tail++] = src;
+	dist[src] = 0;
+	if (pred != NULL) pred[src] = src;
+	
+	while (head < tail) {
+		PlaceId curr = queue[head++];
+		if (dist[curr] == maxDepth) continue;
+		PlaceSet next = neighbours(curr, dist[curr], arg);
+		for (PlaceId p; (p = placeSetPop(&next)) != NOWHERE; ) {
+			if (dist[p] == -1) {
+				dist[p] = dist[curr] + 1;
+				if (pred != NULL) pred[p] = curr;
+				queue[tail++] = p;
+			}
+		}
+	}
+	return tail;
+}
+
+/**
+ * Gets the places within maxDepth steps of src (or BFS_NO_LIMIT),
+ * including src itself.
+ */
+static inline PlaceSet bfsWithin(PlaceId src, int maxDepth,
+                                 BfsNeighbours neighbours, void *arg)
+{
+	PlaceSet reached = placeSetOf(src);
+	PlaceSet frontier = reached;
+	for (int depth = 0; depth != maxDepth && !placeSetIsEmpty(frontier);
+	     depth++) {
+		PlaceSet next = PLACE_SET_EMPTY;
+		for (PlaceId p; (p = placeSetPop(&frontier)) != NOWHERE; ) {
+			next = placeSetUnion(next, neighbours(p, depth, arg));
+		}
+		frontier = placeSetMinus(next, reached);
+		reached = placeSetUnion(reached, frontier);
+	}
+	return reached;
+}
+
+#endif // !defined(FOD__BFS_H_)
@@ -0,0 +1,185 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// Decision.c: the per-turn clock, for anytime move decisions
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Arena.h"
+#include "Decision.h"
+#include "Game.h"
+#include "Places.h"
+
+#define DEFAULT_MARGIN_MSECS 150
+
+// Enough for a decision's view results without growing
+#define ARENA_BLOCK_SIZE     (16 * 1024)
+
+// Spreads each decision's seed out (Knuth's multiplicative hash)
+#define SEED_STEP 2654435761u
+
+// The clock and counters for the decision being made
+typedef struct decisionState {
+	struct timespec startTime;
+	int             numPublished;
+	unsigned int    baseSeed;
+	unsigned int    numDecisions;
+} DecisionState;
+
+static int turnMsecs = TURN_LIMIT_MSECS;
+static int marginMsecs = DEFAULT_MARGIN_MSECS;
+static int iterations = 0;
+
+// The whole program shares one, so a search's threads all see the same
+// clock, unless a thread has asked for its own
+static DecisionState shared;
+static __thread DecisionState threadState;
+static __thread bool hasThreadState = false;
+
+// Each thread's arena, freed when the thread exits
+static __thread Arena threadArena = NULL;
+static pthread_key_t arenaKey;
+static pthread_once_t arenaKeyOnce = PTHREAD_ONCE_INIT;
+
+static void initDecision(void) __attribute__((constructor));
+static int envInt(const char *name, int fallback);
+static unsigned int envSeed(const char *name);
+static DecisionState *currentState(void);
+static void makeArenaKey(void);
+static void freeArena(void *arena);
+
+/**
+ * Reads the configuration and starts the clock when the program starts,
+ * so the time taken to build the view counts towards the first turn
+ */
+static void initDecision(void) {
+	turnMsecs = envInt("FOD_TURN_MSECS", TURN_LIMIT_MSECS);
+	marginMsecs = envInt("FOD_MARGIN_MSECS", DEFAULT_MARGIN_MSECS);
+	iterations = envInt("FOD_ITERATIONS", 0);
+	shared.baseSeed = envSeed("FOD_SEED");
+	decisionBegin();
+}
+
+static int envInt(const char *name, int fallback) {
+	const char *value = getenv(name);
+	if (value == NULL || value[0] == '\0') {
+		return fallback;
+	}
+	
+	char *end;
+	long n = strtol(value, &end, 10);
+	return (*end == '\0' && n >= 0) ? (int) n : fallback;
+}
+
+static unsigned int envSeed(const char *name) {
+	const char *value = getenv(name);
+	if (value != NULL && value[0] != '\0') {
+		char *end;
+		unsigned long seed = strtoul(value, &end, 10);
+		if (*end == '\0') return (unsigned int) seed;
+	}
+	return (unsigned int) time(NULL) ^ (unsigned int) getpid();
+}
+
+static DecisionState *currentState(void) {
+	return hasThreadState ? &threadState : &shared;
+}
+
+static void makeArenaKey(void) {
+	pthread_key_create(&arenaKey, freeArena);
+}
+
+static void freeArena(void *arena) {
+	ArenaFree(arena);
+}
+
+////////////////////////////////////////////////////////////////////////
+
+void decisionBegin(void)
+{
+	DecisionState *state = currentState();
+	clock_gettime(CLOCK_MONOTONIC, &state->startTime);
+	state->numPublished = 0;
+	state->numDecisions++;
+}
+
+void decisionUseThreadState(unsigned int seed)
+{
+	threadState = (DecisionState) { .baseSeed = seed };
+	hasThreadState = true;
+	decisionBegin();
+}
+
+int decisionTimeElapsed(void)
+{
+	DecisionState *state = currentState();
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - state->startTime.tv_sec) * 1000
+	     + (now.tv_nsec - state->startTime.tv_nsec) / 1000000;
+}
+
+int decisionTimeRemaining(void)
+{
+	return turnMsecs - marginMsecs - decisionTimeElapsed();
+}
+
+bool decisionTimeUp(void)
+{
+	return iterations == 0 && decisionTimeRemaining() <= 0;
+}
+
+void decisionSetBudget(int newTurnMsecs, int newMarginMsecs)
+{
+	turnMsecs = newTurnMsecs;
+	marginMsecs = newMarginMsecs;
+}
+
+int decisionIterations(void)
+{
+	return iterations;
+}
+
+void decisionSetIterations(int newIterations)
+{
+	iterations = newIterations;
+}
+
+unsigned int decisionSeed(void)
+{
+	DecisionState *state = currentState();
+	return state->baseSeed + state->numDecisions * SEED_STEP;
+}
+
+void decisionSetSeed(unsigned int seed)
+{
+	DecisionState *state = currentState();
+	state->baseSeed = seed;
+	state->numDecisions = 0;
+}
+
+void decisionPublish(PlaceId move, char *message)
+{
+	currentState()->numPublished++;
+	registerBestPlay((char *) placeIdToAbbrev(move), message);
+}
+
+int decisionNumPublished(void)
+{
+	return currentState()->numPublished;
+}
+
+Arena decisionArena(void)
+{
+	if (threadArena == NULL) {
+		pthread_once(&arenaKeyOnce, makeArenaKey);
+		threadArena = ArenaNew(ARENA_BLOCK_SIZE);
+		pthread_setspecific(arenaKey, threadArena);
+	}
+	return threadArena;
+}
@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// Decision.h: the per-turn clock, for anytime move decisions
+//
+// The referee gives each turn TURN_LIMIT_MSECS, and plays whatever move
+// was registered last when time runs out. So an AI can register a safe
+// move straight away, then keep searching and register a better one
+// each time an iteration finishes, until it's close to the deadline.
+//
+// The budget and safety margin are read from the environment when the
+// program starts:
+//     FOD_TURN_MSECS    the time allowed per turn (TURN_LIMIT_MSECS)
+//     FOD_MARGIN_MSECS  how long before the end to stop searching (150)
+//     FOD_SEED          the random seed for searches (default: from the
+//                       time and process id)
+//     FOD_ITERATIONS    if set, how many iterations each search thread
+//                       runs, in place of the deadline (default 0: none)
+//
+// The clock makes a search's result depend on how fast it ran, so a
+// seed alone doesn't make a game repeatable; a fixed number of
+// iterations (and of threads, FOD_THREADS) does.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+
+#include "Arena.h"
+#include "Game.h"
+#include "Places.h"
+
+#ifndef FOD__DECISION_H_
+#define FOD__DECISION_H_
+
+/**
+ * Starts the clock for a new decision. The clock also starts when the
+ * program does, so this only needs to be called when one process makes
+ * several decisions.
+ */
+void decisionBegin(void);
+
+/**
+ * Gives the calling thread a clock, seed and count of published moves
+ * of its own (starting from `seed`), so that several threads can make
+ * decisions at once. Other threads still see the shared clock, so the
+ * searches for these decisions should stay on the calling thread
+ * (parallelSetThreads(1)).
+ */
+void decisionUseThreadState(unsigned int seed);
+
+/** Milliseconds since the decision began. */
+int decisionTimeElapsed(void);
+
+/**
+ * Milliseconds left to search before the deadline (the turn budget less
+ * the safety margin). Negative once the deadline has passed.
+ */
+int decisionTimeRemaining(void);
+
+/**
+ * Whether the deadline has passed. Never true while searches have a
+ * fixed number of iterations, so they all run to the end.
+ */
+bool decisionTimeUp(void);
+
+/** Overrides the per-turn budget and safety margin, in milliseconds. */
+void decisionSetBudget(int turnMsecs, int marginMsecs);
+
+/**
+ * How many iterations each search thread should run for, in place of
+ * the deadline, or 0 to search until the deadline. An AI passes this
+ * on as its search's iteration limit.
+ */
+int decisionIterations(void);
+
+/** Overrides the number of iterations per search (0 for none). */
+void decisionSetIterations(int iterations);
+
+/**
+ * A random seed for this decision's search. Each decision gets a
+ * different one, so a game played from a given seed plays the same way
+ * each time, if the searches have a fixed number of iterations.
+ */
+unsigned int decisionSeed(void);
+
+/** Overrides the random seed, e.g. so a referee can replay a game. */
+void decisionSetSeed(unsigned int seed);
+
+/**
+ * Registers the given move (with registerBestPlay) as the best so far.
+ * Can be called any number of times; the last call wins. The move is
+ * counted before it's registered, so registerBestPlay can tell it from
+ * one registered directly.
+ */
+void decisionPublish(PlaceId move, char *message);
+
+/** Number of moves published since the decision began. */
+int decisionNumPublished(void);
+
+/**
+ * The calling thread's arena for a decision's view results (see
+ * Arena.h), made the first time it's asked for. An AI uses it while it
+ * decides, and resets it at the end, so none of the arrays it was given
+ * need freeing.
+ */
+Arena decisionArena(void);
+
+#endif // !defined(FOD__DECISION_H_)
@@ -0,0 +1,308 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// DraculaMcts.c: Monte Carlo tree search over Dracula's moves
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Decision.h"
+#include "DraculaMcts.h"
+#include "DraculaView.h"
+#include "Game.h"
+#include "GameView.h"
+#include "Parallel.h"
+#include "Places.h"
+#include "Random.h"
+#include "Rollout.h"
+
+#define MAX_NODES       (1 << 16)
+#define MAX_DEPTH       64
+#define ROLLOUT_ROUNDS  8
+
+// UCB1 exploration constant
+#define EXPLORATION     0.7
+
+// How often (in iterations) to check the clock
+#define CLOCK_INTERVAL  16
+
+#define UNEXPANDED      (-1)
+
+typedef struct mctsNode {
+	PlaceId move;        // Dracula's move into this node
+	int     visits;
+	double  totalValue;
+	int     firstChild;  // index of the first child in the pool
+	int     numChildren; // UNEXPANDED until the node is expanded
+} MctsNode;
+
+struct draculaMcts {
+	MctsNode *nodes;     // node pool; the root is always nodes[0]
+	int       numNodes;
+
+	// Identifies the position at the root
+	uint64_t  rootHash;
+	int       rootScore;
+
+	Random    rng;
+};
+
+static void    resetTree(DraculaMcts dm);
+static int     iterate(DraculaMcts dm, DraculaView work);
+static bool    expand(DraculaMcts dm, int node, DraculaView work);
+static int     selectChild(DraculaMcts dm, int node);
+static int     makeHunterMoves(DraculaMcts dm, DraculaView work);
+static int     searchShare(void *state, MctsMoveStats stats[]);
+
+////////////////////////////////////////////////////////////////////////
+// Constructor/Destructor
+
+DraculaMcts DmNew(unsigned int seed)
+{
+	DraculaMcts dm = malloc(sizeof(*dm));
+	if (dm == NULL) {
+		fprintf(stderr, "Couldn't allocate DraculaMcts\n");
+		exit(EXIT_FAILURE);
+	}
+
+	dm->nodes = malloc(MAX_NODES * sizeof(MctsNode));
+	if (dm->nodes == NULL) {
+		fprintf(stderr, "Couldn't allocate DraculaMcts\n");
+		exit(EXIT_FAILURE);
+	}
+
+	dm->numNodes = 0;
+	randomSeed(&dm->rng, seed);
+	return dm;
+}
+
+void DmFree(DraculaMcts dm)
+{
+	free(dm->nodes);
+	free(dm);
+}
+
+////////////////////////////////////////////////////////////////////////
+// Searching
+
+int DmSearch(DraculaMcts dm, DraculaView dv, int maxIterations)
+{
+	// Carry on with the tree if it was built for this same position
+	uint64_t hash = GvGetHash(DvGetGameView(dv));
+	if (dm->numNodes == 0 || hash != dm->rootHash) {
+		resetTree(dm);
+	}
+	dm->rootHash = hash;
+	dm->rootScore = DvGetScore(dv);
+
+	// Every iteration undoes its own moves, so one copy of the view
+	// does for the whole search
+	DraculaView work = DvClone(dv);
+	int n = 0;
+	while (maxIterations == 0 || n < maxIterations) {
+		if (n % CLOCK_INTERVAL == 0 && decisionTimeUp()) break;
+		iterate(dm, work);
+		n++;
+	}
+	DvFree(work);
+	return n;
+}
+
+PlaceId DmBestMove(DraculaMcts dm)
+{
+	if (dm->numNodes == 0 || dm->nodes[0].numChildren <= 0) {
+		return NOWHERE;
+	}
+
+	MctsNode *root = &dm->nodes[0];
+	MctsNode *best = &dm->nodes[root->firstChild];
+	for (int i = 1; i < root->numChildren; i++) {
+		MctsNode *child = &dm->nodes[root->firstChild + i];
+		if (child->visits > best->visits) {
+			best = child;
+		}
+	}
+	return best->move;
+}
+
+int DmGetRootStats(DraculaMcts dm, MctsMoveStats stats[])
+{
+	if (dm->numNodes == 0 || dm->nodes[0].numChildren <= 0) {
+		return 0;
+	}
+
+	MctsNode *root = &dm->nodes[0];
+	for (int i = 0; i < root->numChildren; i++) {
+		MctsNode *child = &dm->nodes[root->firstChild + i];
+		stats[i].move = child->move;
+		stats[i].visits = child->visits;
+		stats[i].value = child->visits > 0
+		               ? child->totalValue / child->visits : 0.0;
+	}
+	return root->numChildren;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Searching on several threads
+
+// One thread's share of a parallel search. DmSearch makes its own copy
+// of the view, so the threads can all start from the same one.
+typedef struct searchShare {
+	DraculaMcts dm;
+	DraculaView dv;
+	int         maxIterations;
+} SearchShare;
+
+int DmSearchParallel(DraculaView dv, unsigned int seed, int numThreads,
+                     int maxIterations, MctsMoveStats stats[])
+{
+	SearchShare shares[MAX_THREADS];
+	void *states[MAX_THREADS];
+	if (numThreads > MAX_THREADS) numThreads = MAX_THREADS;
+	for (int i = 0; i < numThreads; i++) {
+		shares[i] = (SearchShare) {
+			.dm = DmNew(parallelThreadSeed(seed, i)),
+			.dv = dv,
+			.maxIterations = maxIterations,
+		};
+		states[i] = &shares[i];
+	}
+
+	int numMoves = parallelSearch(searchShare, states, numThreads, stats);
+	for (int i = 0; i < numThreads; i++) {
+		DmFree(shares[i].dm);
+	}
+	return numMoves;
+}
+
+static int searchShare(void *state, MctsMoveStats stats[]) {
+	SearchShare *share = state;
+	DmSearch(share->dm, share->dv, share->maxIterations);
+	return DmGetRootStats(share->dm, stats);
+}
+
+////////////////////////////////////////////////////////////////////////
+// Starting a new tree
+
+static void resetTree(DraculaMcts dm) {
+	dm->nodes[0] = (MctsNode) {
+		.move = NOWHERE, .visits = 0, .totalValue = 0.0,
+		.firstChild = 0, .numChildren = UNEXPANDED,
+	};
+	dm->numNodes = 1;
+}
+
+////////////////////////////////////////////////////////////////////////
+// One iteration: select, expand, roll out, back up
+
+static int iterate(DraculaMcts dm, DraculaView work) {
+	int path[MAX_DEPTH + 1];
+	int depth = 0;
+	int numMade = 0;
+
+	path[0] = 0;
+	int node = 0;
+	while (depth < MAX_DEPTH && !rolloutIsOver(work)) {
+		if (dm->nodes[node].numChildren == UNEXPANDED &&
+		    !expand(dm, node, work)) {
+			break;
+		}
+
+		node = selectChild(dm, node);
+		path[++depth] = node;
+		DvMakeMove(work, dm->nodes[node].move);
+		numMade++;
+		if (!rolloutIsOver(work)) {
+			numMade += makeHunterMoves(dm, work);
+		}
+		if (dm->nodes[node].visits == 0) break;
+	}
+
+	numMade += rolloutPlay(work, ROLLOUT_ROUNDS, &dm->rng);
+	double value = rolloutScore(work, dm->rootScore);
+	for (int i = 0; i <= depth; i++) {
+		dm->nodes[path[i]].visits++;
+		dm->nodes[path[i]].totalValue += value;
+	}
+
+	for (; numMade > 0; numMade--) {
+		DvUnmakeMove(work);
+	}
+	return depth;
+}
+
+/**
+ * Gives the node a child for each of Dracula's valid moves (or just
+ * TELEPORT if he has none). Fails if the pool is full.
+ */
+static bool expand(DraculaMcts dm, int node, DraculaView work) {
+	PlaceId moves[NUM_REAL_PLACES];
+	int numMoves = DvFillValidMoves(work, moves);
+	int numChildren = (numMoves > 0 ? numMoves : 1);
+	if (dm->numNodes + numChildren > MAX_NODES) {
+		return false;
+	}
+
+	int first = dm->numNodes;
+	for (int i = 0; i < numChildren; i++) {
+		dm->nodes[first + i] = (MctsNode) {
+			.move = (numMoves > 0 ? moves[i] : TELEPORT),
+			.visits = 0, .totalValue = 0.0,
+			.firstChild = 0, .numChildren = UNEXPANDED,
+		};
+	}
+	dm->numNodes += numChildren;
+	dm->nodes[node].firstChild = first;
+	dm->nodes[node].numChildren = numChildren;
+	return true;
+}
+
+/**
+ * Picks a child by UCB1, trying each child once first (in a random
+ * order)
+ */
+static int selectChild(DraculaMcts dm, int node) {
+	MctsNode *parent = &dm->nodes[node];
+	double logVisits = log(parent->visits > 0 ? parent->visits : 1);
+
+	int best = parent->firstChild;
+	double bestScore = -1.0;
+	int numUnvisited = 0;
+	for (int i = 0; i < parent->numChildren; i++) {
+		int c = parent->firstChild + i;
+		MctsNode *child = &dm->nodes[c];
+		if (child->visits == 0) {
+			// Reservoir sampling over the unvisited children
+			numUnvisited++;
+			if (randomBelow(&dm->rng, numUnvisited) == 0) best = c;
+			continue;
+		}
+		if (numUnvisited > 0) continue;
+
+		double score = child->totalValue / child->visits
+		             + EXPLORATION * sqrt(logVisits / child->visits);
+		if (score > bestScore) {
+			bestScore = score;
+			best = c;
+		}
+	}
+	return best;
+}
+
+/**
+ * Plays the hunters' moves up to Dracula's next turn, and returns how
+ * many moves were made
+ */
+static int makeHunterMoves(DraculaMcts dm, DraculaView work) {
+	GameView gv = DvGetGameView(work);
+	int numMade = 0;
+	while (GvGetPlayer(gv) != PLAYER_DRACULA && !rolloutIsOver(work)) {
+		DvMakeMove(work, rolloutHunterMove(work, &dm->rng));
+		numMade++;
+	}
+	return numMade;
+}
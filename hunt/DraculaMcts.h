@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// DraculaMcts.h: Monte Carlo tree search over Dracula's moves
+//
+// The tree only branches on Dracula's moves (from DvGetValidMoves); the
+// hunters' replies are played by a fast rollout policy each time a path
+// is walked, so each node's statistics average over how the hunters
+// might respond. Since those statistics come from made-up hunter
+// positions, the tree is only kept for a search of the same position.
+//
+// Leaves are scored from Dracula's point of view, between 0 (caught)
+// and 1 (the game score has run out), by his blood points and how much
+// the game score has dropped since the search began.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "DraculaView.h"
+#include "Places.h"
+#include "Rollout.h"
+
+#ifndef FOD__DRACULA_MCTS_H_
+#define FOD__DRACULA_MCTS_H_
+
+typedef struct draculaMcts *DraculaMcts;
+
+/**
+ * Creates a search with an empty tree. The seed drives the rollouts, so
+ * a fixed seed and iteration count give the same result every time.
+ */
+DraculaMcts DmNew(unsigned int seed);
+
+/** Frees all memory allocated for the given search. */
+void DmFree(DraculaMcts dm);
+
+/**
+ * Searches from the given view, which must be at Dracula's turn (after
+ * his first move, since the search doesn't choose where he starts), until
+ * maxIterations iterations have been done (no limit if it's 0) or the
+ * decision deadline passes (see Decision.h). If the tree was built for
+ * this same position (by its hash), the search carries on from what's
+ * already there; otherwise it starts a new tree. Returns the number of
+ * iterations done.
+ */
+int DmSearch(DraculaMcts dm, DraculaView dv, int maxIterations);
+
+/**
+ * Returns the move the search tried most often, or NOWHERE if it hasn't
+ * searched yet.
+ */
+PlaceId DmBestMove(DraculaMcts dm);
+
+/**
+ * Writes the statistics for each of Dracula's moves from the position
+ * searched, and returns how many there were. `stats` needs room for
+ * NUM_REAL_PLACES moves.
+ */
+int DmGetRootStats(DraculaMcts dm, MctsMoveStats stats[]);
+
+/**
+ * Searches from the given view on numThreads threads at once, each with
+ * a fresh tree and its own seed (see Parallel.h), and writes their root
+ * statistics, merged, into `stats`. With one thread this is the same as
+ * DmSearch on DmNew(seed). Returns the number of moves in `stats`.
+ */
+int DmSearchParallel(DraculaView dv, unsigned int seed, int numThreads,
+                     int maxIterations, MctsMoveStats stats[]);
+
+#endif // !defined(FOD__DRACULA_MCTS_H_)
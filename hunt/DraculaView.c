@@ -20,7 +20,7 @@
 #include "Map.h"
 #include "Places.h"
 // add your own #includes here
-#include "Queue.h"
+#include "Arena.h"
 #include "utils.h"
 
 struct draculaView {
@@ -91,6 +91,52 @@ void DvFree(DraculaView dv)
 	free(dv);
 }
 
+void DvApplyPlay(DraculaView dv, const char play[8])
+{
+	GvApplyPlay(dv->gv, play);
+	fillTrail(dv);
+}
+
+DraculaView DvClone(DraculaView dv)
+{
+	DraculaView copy = DvNew("", NULL);
+	GvCloneInto(copy->gv, dv->gv);
+	fillTrail(copy);
+	return copy;
+}
+
+void DvMakeMove(DraculaView dv, PlaceId move)
+{
+	char play[8];
+	GvBuildPlay(dv->gv, move, play);
+	GvMakeMove(dv->gv, play);
+	fillTrail(dv);
+}
+
+void DvUnmakeMove(DraculaView dv)
+{
+	GvUnmakeMove(dv->gv);
+	fillTrail(dv);
+}
+
+void DvCloneFrom(DraculaView dv, GameView gv)
+{
+	GvCloneInto(dv->gv, gv);
+	fillTrail(dv);
+}
+
+void DvDeterminise(DraculaView dv, const PlaceId locations[],
+                   int numLocations)
+{
+	GvDeterminise(dv->gv, locations, numLocations);
+	fillTrail(dv);
+}
+
+GameView DvGetGameView(DraculaView dv)
+{
+	return dv->gv;
+}
+
 ////////////////////////////////////////////////////////////////////////
 // Game State Information
 
@@ -149,33 +195,39 @@ PlaceId *DvGetValidMoves(DraculaView dv, int *numReturnedMoves)
 
 	// There can't be more than NUM_REAL_PLACES
 	// valid moves
-	PlaceId *moves = malloc(NUM_REAL_PLACES * sizeof(PlaceId));
-	assert(moves != NULL);
+	PlaceId *moves = ArenaAllocResult(NUM_REAL_PLACES * sizeof(PlaceId));
 	
-	*numReturnedMoves = 0;
-	addLocationMoves(dv, moves, numReturnedMoves);
-	addDoubleBackMoves(dv, moves, numReturnedMoves);
-	addHideMoves(dv, moves, numReturnedMoves);
+	*numReturnedMoves = DvFillValidMoves(dv, moves);
 	return moves;
 }
 
+int DvFillValidMoves(DraculaView dv, PlaceId moves[])
+{
+	int numMoves = 0;
+	if (DvWhereAmI(dv) == NOWHERE) {
+		return 0;
+	}
+	
+	addLocationMoves(dv, moves, &numMoves);
+	addDoubleBackMoves(dv, moves, &numMoves);
+	addHideMoves(dv, moves, &numMoves);
+	return numMoves;
+}
+
 static void addLocationMoves(DraculaView dv, PlaceId *moves,
                              int *numReturnedMoves) {
 	// Get the locations that Dracula can reach (we pass 1 as the round
 	// number, since Dracula's movement doesn't depend on round number)
-	int numLocs = 0;
-	PlaceId *locs = GvGetReachable(dv->gv, PLAYER_DRACULA, 1,
-	                               DvWhereAmI(dv), &numLocs);
+	PlaceSet locs = GvGetReachableSet(dv->gv, PLAYER_DRACULA, 1,
+	                                  DvWhereAmI(dv), true, true, true);
 	
 	// For each location, check if it's a legal move, and add it to the
 	// moves array if so
-	for (int i = 0; i < numLocs; i++) {
-		if (moveIsLegal(dv, locs[i])) {
-			moves[(*numReturnedMoves)++] = locs[i];
+	for (PlaceId loc; (loc = placeSetPop(&locs)) != NOWHERE; ) {
+		if (moveIsLegal(dv, loc)) {
+			moves[(*numReturnedMoves)++] = loc;
 		}
 	}
-	
-	free(locs);
 }
 
 static void addDoubleBackMoves(DraculaView dv, PlaceId *moves,
@@ -219,12 +271,9 @@ static bool trailContains(DraculaView dv, PlaceId move) {
 }
 
 static bool canReach(DraculaView dv, PlaceId location) {
-	int numLocs = 0;
-	PlaceId *places = GvGetReachable(dv->gv, PLAYER_DRACULA, 1,
-	                                 DvWhereAmI(dv), &numLocs);
-	bool result = placesContains(places, numLocs, location);
-	free(places);
-	return result;
+	PlaceSet places = GvGetReachableSet(dv->gv, PLAYER_DRACULA, 1,
+	                                    DvWhereAmI(dv), true, true, true);
+	return placeSetContains(places, location);
 }
 
 /**
@@ -360,4 +409,17 @@ PlaceId *DvGetLocationHistory(DraculaView dv, int *numReturnedLocs)
 {
 	bool canFree = true;
 	return GvGetLocationHistory(dv->gv, PLAYER_DRACULA, numReturnedLocs, &canFree);
+}
+
+PlaceId DvResolveMove(DraculaView dv, PlaceId move)
+{
+	if (move == HIDE) {
+		return DvWhereAmI(dv);
+	} else if (isDoubleBack(move)) {
+		return resolveDoubleBack(dv, move);
+	} else if (move == TELEPORT) {
+		return CASTLE_DRACULA;
+	} else {
+		return move;
+	}
 }
\ No newline at end of file
@@ -19,6 +19,7 @@
 #include <stdbool.h>
 
 #include "Game.h"
+#include "GameView.h"
 #include "Places.h"
 
 typedef struct draculaView *DraculaView;
@@ -51,6 +52,49 @@ DraculaView DvNew(char *pastPlays, Message messages[]);
  */
 void DvFree(DraculaView dv);
 
+/**
+ * Advances  the  view  by a single play (see GvApplyPlay). This is much
+ * cheaper than creating a new view from the extended pastPlays string.
+ */
+void DvApplyPlay(DraculaView dv, const char play[8]);
+
+/**
+ * Makes  a copy of `dv` that can be changed without affecting it. Free
+ * the copy with DvFree.
+ */
+DraculaView DvClone(DraculaView dv);
+
+/**
+ * Makes the given move for the current player (Dracula or a hunter),
+ * working out everything it sets off with GvBuildPlay, so that it can
+ * be taken back with DvUnmakeMove. Used to search ahead.
+ */
+void DvMakeMove(DraculaView dv, PlaceId move);
+
+/**
+ * Takes back the most recent DvMakeMove.
+ */
+void DvUnmakeMove(DraculaView dv);
+
+/**
+ * Makes `dv` a copy of the given game view, reusing the memory `dv`
+ * already has. The game view can be any player's, e.g. a hunter's view
+ * that is then filled in with DvDeterminise.
+ */
+void DvCloneFrom(DraculaView dv, GameView gv);
+
+/**
+ * Fills in where Dracula was for his last numLocations moves (see
+ * GvDeterminise).
+ */
+void DvDeterminise(DraculaView dv, const PlaceId locations[],
+                   int numLocations);
+
+/**
+ * Returns the game view underneath `dv`. It belongs to `dv`.
+ */
+GameView DvGetGameView(DraculaView dv);
+
 ////////////////////////////////////////////////////////////////////////
 // Game State Information
 
@@ -120,6 +164,13 @@ PlaceId *DvGetTrapLocations(DraculaView dv, int *numTraps);
  */
 PlaceId *DvGetValidMoves(DraculaView dv, int *numReturnedMoves);
 
+/**
+ * Like DvGetValidMoves, but writes the moves to `moves` (which needs
+ * room for NUM_REAL_PLACES moves) instead of allocating an array, and
+ * returns how many there are.
+ */
+int DvFillValidMoves(DraculaView dv, PlaceId moves[]);
+
 /**
  * Gets all the locations that Dracula can move to this turn.
  *
@@ -180,4 +231,10 @@ PlaceId *DvWhereCanTheyGoByType(DraculaView dv, Player player,
 
 // TODO
 PlaceId *DvGetLocationHistory(DraculaView dv, int *numReturnedLocs);
+
+/**
+ * Gets the place Dracula would end up in if he made the given move
+ * (one of the moves from DvGetValidMoves, or TELEPORT).
+ */
+PlaceId DvResolveMove(DraculaView dv, PlaceId move);
 #endif // !defined(FOD__DRACULA_VIEW_H_)
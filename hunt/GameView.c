@@ -15,6 +15,7 @@
 #include <assert.h>
 #include <math.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -24,6 +25,7 @@
 #include "Map.h"
 #include "Places.h"
 // add your own #includes here
+#include "Arena.h"
 #include "utils.h"
 
 ////////////////////////////////////////////////////////////////////////
@@ -31,6 +33,14 @@
 
 #define MAX_TURN_ACTIONS 4
 
+// Dracula places an immature vampire (instead of a trap) in the first
+// round and every VAMPIRE_ROUNDS rounds after that
+#define VAMPIRE_ROUNDS 13
+
+// What Dracula left behind each round (draculaActionHistory)
+#define LEFT_TRAP    1
+#define LEFT_VAMPIRE 2
+
 typedef enum action {
 	ENCOUNTERED_TRAP,
 	ENCOUNTERED_VAMPIRE,
@@ -48,6 +58,26 @@ typedef struct turn {
 	int     numActions;
 } Turn;
 
+////////////////////////////////////////////////////////////////////////
+// Undo record
+
+// Everything a single play can change, apart from the history arrays,
+// which are only ever appended to (so rolling back the round and the
+// current player is enough to discard the entries a play added)
+
+typedef struct undo {
+	Round    round;
+	Player   currentPlayer;
+	int      score;
+	int      playerHealth[NUM_PLAYERS];
+	PlaceId  moverLocation;                // the mover's previous location
+	PlaceId  trapLocations[TRAIL_SIZE];
+	int      numActiveTraps;
+	PlaceId  vampireLocation;
+	bool     restAttempted;
+	uint64_t hash;
+} Undo;
+
 ////////////////////////////////////////////////////////////////////////
 
 // I lump everything into the same struct, because I'd rather have all
@@ -64,10 +94,18 @@ struct gameView {
 	int      numActiveTraps;               // number of active traps
 	PlaceId  vampireLocation;              // location of the immature vampire
 	bool     restAttempted;                // if the hunter attempted to rest
+	uint64_t hash;                         // Zobrist hash of the state
 	
 	// History
 	PlaceId *moveHistory[NUM_PLAYERS];     // each player's move history
 	PlaceId *draculaLocationHistory;       // Dracula's location history
+	unsigned char *draculaActionHistory;   // LEFT_* flags for each round
+	int      historyCapacity;              // number of rounds allocated
+	
+	// Search
+	Undo    *undoStack;                    // one record per GvMakeMove
+	int      undoDepth;                    // number of records in use
+	int      undoCapacity;                 // number of records allocated
 	
 	Map      map;
 };
@@ -76,16 +114,52 @@ struct gameView {
 static int     max(int num1, int num2);
 static int     min(int num1, int num2);
 
+////////////////////////////////////////////////////////////////////////
+// Zobrist hashing
+//
+// The hash covers everything that matters for the rest of the game:
+// player locations, Dracula's trail (by age), the trap multiset, the
+// vampire, bucketed health, the current player and the round modulo 4
+// (which decides how far hunters can go by rail). All state changes go
+// through the setters below so the hash is updated with a few XORs.
+
+// Index for any PlaceId that can appear in the state: real places,
+// then CITY_UNKNOWN .. TELEPORT, then NOWHERE
+#define NUM_HASH_PLACES (NUM_REAL_PLACES + (TELEPORT - CITY_UNKNOWN + 1) + 1)
+#define NUM_HEALTH_BUCKETS 16
+#define DRACULA_HEALTH_BUCKET_SIZE 10
+
+static struct zobristKeys {
+	uint64_t location[NUM_PLAYERS][NUM_HASH_PLACES];
+	uint64_t trail[TRAIL_SIZE][NUM_HASH_PLACES];
+	uint64_t traps[NUM_HASH_PLACES][TRAIL_SIZE + 1];
+	uint64_t vampire[NUM_HASH_PLACES];
+	uint64_t health[NUM_PLAYERS][NUM_HEALTH_BUCKETS];
+	uint64_t player[NUM_PLAYERS];
+	uint64_t railPhase[4];
+} ZOBRIST;
+
+static void     initZobristKeys(void) __attribute__((constructor));
+static int      hashPlaceIndex(PlaceId place);
+static int      healthBucket(Player player, int health);
+static uint64_t trailHash(GameView gv, int numDraculaMoves);
+static uint64_t hashFromScratch(GameView gv);
+static int      numTrapsAt(GameView gv, PlaceId location);
+
+static void     setPlayerLocation(GameView gv, Player player,
+                                  PlaceId location);
+static void     setPlayerHealth(GameView gv, Player player, int health);
+static void     setVampireLocation(GameView gv, PlaceId location);
+
 ////////////////////////////////////////////////////////////////////////
 // Constructor
 
-static Turn   *pastPlaysToTurns(char *pastPlays, int *numTurns);
 static int     pastPlaysToNumTurns(char *pastPlays);
-static Turn    playToTurn(char *play);
+static Turn    playToTurn(const char *play);
 
 static int     numTurnsToNumRounds(int numTurns);
 static void    initGameView(GameView gv, int numRounds);
-static void    processTurns(GameView gv, Turn *turn, int numTurns);
+static void    ensureHistoryCapacity(GameView gv, int numRounds);
 static void    processTurn(GameView gv, Turn turn);
 
 static void    processDraculaTurn(GameView gv, Turn turn);
@@ -119,34 +193,25 @@ GameView GvNew(char *pastPlays, Message messages[])
 		exit(EXIT_FAILURE);
 	}
 	
-	int numTurns = 0;
-	Turn *turns = pastPlaysToTurns(pastPlays, &numTurns);
-	
+	int numTurns = pastPlaysToNumTurns(pastPlays);
 	int numRounds = numTurnsToNumRounds(numTurns);
 	initGameView(gv, numRounds);
-	processTurns(gv, turns, numTurns);
-	free(turns);
 	
 	gv->map = MapNew();
+	
+	for (int i = 0; i < numTurns; i++) {
+		// Hack to avoid string splitting
+		GvApplyPlay(gv, &pastPlays[i * 8]);
+	}
 	return gv;
 }
 
 /**
- * Converts a pastPlays string to an array of Turn structs, and sets
- * *numTurns to the number of turns
+ * Advances the game view by a single play
  */
-static Turn *pastPlaysToTurns(char *pastPlays, int *numTurns) {
-	*numTurns = pastPlaysToNumTurns(pastPlays);
-	Turn *turns = malloc(*numTurns * sizeof(Turn));
-	if (turns == NULL) {
-		fprintf(stderr, "Insufficient memory!\n");
-		exit(EXIT_FAILURE);
-	}
-	for (int i = 0; i < *numTurns; i++) {
-		// Hack to avoid string splitting
-		turns[i] = playToTurn(&pastPlays[i * 8]);
-	}
-	return turns;
+void GvApplyPlay(GameView gv, const char play[8])
+{
+	processTurn(gv, playToTurn(play));
 }
 
 /**
@@ -172,7 +237,7 @@ static int pastPlaysToNumTurns(char *pastPlays) {
 /**
  * Converts a play string to a Turn struct
  */
-static Turn playToTurn(char *play) {
+static Turn playToTurn(const char *play) {
 	Turn turn = {};
 	
 	switch (play[0]) {
@@ -233,18 +298,52 @@ static void initGameView(GameView gv, int numRounds) {
 	gv->numActiveTraps = 0;
 	gv->vampireLocation = NOWHERE;
 	gv->restAttempted = false;
+	gv->hash = hashFromScratch(gv);
 	
 	// History
 	for (int i = 0; i < NUM_PLAYERS; i++) {
-		gv->moveHistory[i] = malloc(numRounds * sizeof(PlaceId));
+		gv->moveHistory[i] = NULL;
 	}
-	gv->draculaLocationHistory = malloc(numRounds * sizeof(PlaceId));
+	gv->draculaLocationHistory = NULL;
+	gv->draculaActionHistory = NULL;
+	gv->historyCapacity = 0;
+	ensureHistoryCapacity(gv, numRounds);
+	
+	// Search
+	gv->undoStack = NULL;
+	gv->undoDepth = 0;
+	gv->undoCapacity = 0;
 }
 
-static void processTurns(GameView gv, Turn *turns, int numTurns) {
-	for (int i = 0; i < numTurns; i++) {
-		processTurn(gv, turns[i]);
+/**
+ * Makes sure the history arrays have room for at least the given number
+ * of rounds. The arrays grow geometrically, so a view that is advanced
+ * one play at a time only reallocates O(log n) times.
+ */
+static void ensureHistoryCapacity(GameView gv, int numRounds) {
+	if (numRounds <= gv->historyCapacity) {
+		return;
+	}
+	
+	int capacity = max(gv->historyCapacity * 2, max(numRounds, 8));
+	for (int i = 0; i < NUM_PLAYERS; i++) {
+		gv->moveHistory[i] = realloc(gv->moveHistory[i],
+		                             capacity * sizeof(PlaceId));
+		if (gv->moveHistory[i] == NULL) {
+			fprintf(stderr, "Insufficient memory!\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	gv->draculaLocationHistory = realloc(gv->draculaLocationHistory,
+	                                     capacity * sizeof(PlaceId));
+	gv->draculaActionHistory = realloc(gv->draculaActionHistory,
+	                                   capacity * sizeof(unsigned char));
+	if (gv->draculaLocationHistory == NULL ||
+	    gv->draculaActionHistory == NULL) {
+		fprintf(stderr, "Insufficient memory!\n");
+		exit(EXIT_FAILURE);
 	}
+	gv->historyCapacity = capacity;
 }
 
 /**
@@ -252,6 +351,10 @@ static void processTurns(GameView gv, Turn *turns, int numTurns) {
  */
 static void processTurn(GameView gv, Turn turn) {
 	assert(gv->currentPlayer == turn.player);
+	ensureHistoryCapacity(gv, gv->round + 1);
+	
+	gv->hash ^= ZOBRIST.player[gv->currentPlayer];
+	gv->hash ^= ZOBRIST.railPhase[gv->round % 4];
 	
 	if (gv->currentPlayer == PLAYER_DRACULA) {
 		processDraculaTurn(gv, turn);
@@ -263,9 +366,13 @@ static void processTurn(GameView gv, Turn turn) {
 	// Passes the turn to the next player
 	gv->currentPlayer = (gv->currentPlayer + 1) % NUM_PLAYERS;
 	
+	gv->hash ^= ZOBRIST.player[gv->currentPlayer];
+	gv->hash ^= ZOBRIST.railPhase[gv->round % 4];
+	
 	// Revives the next player
 	if (gv->playerHealth[gv->currentPlayer] == 0) {
-		gv->playerHealth[gv->currentPlayer] = GAME_START_HUNTER_LIFE_POINTS;
+		setPlayerHealth(gv, gv->currentPlayer,
+		                GAME_START_HUNTER_LIFE_POINTS);
 	}
 }
 
@@ -282,15 +389,18 @@ static void processDraculaTurn(GameView gv, Turn turn) {
 }
 
 static void processDraculaMove(GameView gv, Turn turn) {
-	// Store the move in the move history
+	// Store the move in the move history, moving the trail along
+	gv->hash ^= trailHash(gv, gv->round);
 	gv->moveHistory[PLAYER_DRACULA][gv->round] = turn.move;
+	gv->hash ^= trailHash(gv, gv->round + 1);
 	
 	// Resolve the move to a location, in case it was a special move
 	// and update Dracula's location
-	gv->playerLocations[PLAYER_DRACULA] = resolveDraculaMove(gv, turn.move);
+	setPlayerLocation(gv, PLAYER_DRACULA, resolveDraculaMove(gv, turn.move));
 	
 	// Store the location in the location history
 	gv->draculaLocationHistory[gv->round] = gv->playerLocations[PLAYER_DRACULA];
+	gv->draculaActionHistory[gv->round] = 0;
 }
 
 static PlaceId resolveDraculaMove(GameView gv, PlaceId move) {
@@ -328,14 +438,21 @@ static void processDraculaActions(GameView gv, Turn turn) {
  * Dracula placed a trap
  */
 static void processTrapPlaced(GameView gv) {
-	gv->trapLocations[gv->numActiveTraps++] = gv->playerLocations[PLAYER_DRACULA];
+	PlaceId location = gv->playerLocations[PLAYER_DRACULA];
+	int numTraps = numTrapsAt(gv, location);
+	gv->hash ^= ZOBRIST.traps[hashPlaceIndex(location)][numTraps];
+	gv->hash ^= ZOBRIST.traps[hashPlaceIndex(location)][numTraps + 1];
+	
+	gv->trapLocations[gv->numActiveTraps++] = location;
+	gv->draculaActionHistory[gv->round] |= LEFT_TRAP;
 }
 
 /**
  * Dracula placed a vampire
  */
 static void processVampirePlaced(GameView gv) {
-	gv->vampireLocation = gv->playerLocations[PLAYER_DRACULA];
+	setVampireLocation(gv, gv->playerLocations[PLAYER_DRACULA]);
+	gv->draculaActionHistory[gv->round] |= LEFT_VAMPIRE;
 }
 
 /**
@@ -349,7 +466,7 @@ static void processMalfunctionedTrap(GameView gv) {
  * A vampire matured
  */
 static void processMaturedVampire(GameView gv) {
-	gv->vampireLocation = NOWHERE;
+	setVampireLocation(gv, NOWHERE);
 	gv->score -= SCORE_LOSS_VAMPIRE_MATURES;
 }
 
@@ -364,7 +481,8 @@ static void processDraculaEndOfTurn(GameView gv) {
 }
 
 static void processDraculaLifeGain(GameView gv, int amount) {
-	gv->playerHealth[PLAYER_DRACULA] += amount;
+	setPlayerHealth(gv, PLAYER_DRACULA,
+	                gv->playerHealth[PLAYER_DRACULA] + amount);
 }
 
 ///////////////////
@@ -390,7 +508,7 @@ static void processHunterMove(GameView gv, Turn turn) {
 	gv->restAttempted = (turn.move == gv->playerLocations[gv->currentPlayer]);
 	
 	// Update the hunter's location
-	gv->playerLocations[gv->currentPlayer] = turn.move;
+	setPlayerLocation(gv, gv->currentPlayer, turn.move);
 }
 
 /**
@@ -408,7 +526,7 @@ static void processHunterActions(GameView gv, Turn turn) {
 	
 	// If the hunter died :(
 	if (gv->playerHealth[gv->currentPlayer] == 0) {
-		gv->playerLocations[gv->currentPlayer] = ST_JOSEPH_AND_ST_MARY;
+		setPlayerLocation(gv, gv->currentPlayer, ST_JOSEPH_AND_ST_MARY);
 		gv->score -= SCORE_LOSS_HUNTER_HOSPITAL;
 	}
 }
@@ -425,7 +543,7 @@ static void processTrapEncountered(GameView gv) {
  * The current player encounters an immature vampire
  */
 static void processVampireEncountered(GameView gv) {
-	gv->vampireLocation = NOWHERE;
+	setVampireLocation(gv, NOWHERE);
 }
 
 /**
@@ -447,8 +565,8 @@ static void processHunterEndOfTurn(GameView gv) {
  * The given hunter gains some life points
  */
 static void processHunterLifeGain(GameView gv, Player hunter, int amount) {
-	gv->playerHealth[hunter] = min(gv->playerHealth[hunter] + amount,
-	                               GAME_START_HUNTER_LIFE_POINTS);
+	setPlayerHealth(gv, hunter, min(gv->playerHealth[hunter] + amount,
+	                                GAME_START_HUNTER_LIFE_POINTS));
 }
 
 /////////////////////
@@ -458,6 +576,16 @@ static void processHunterLifeGain(GameView gv, Player hunter, int amount) {
  * Removes a trap from the given location
  */
 static void processRemoveTrap(GameView gv, PlaceId location) {
+	// A hunter can set off a trap in a city they didn't know Dracula had
+	// been to, in which case it's one of the traps in unknown cities
+	if (numTrapsAt(gv, location) == 0) {
+		location = CITY_UNKNOWN;
+	}
+	
+	int numTraps = numTrapsAt(gv, location);
+	gv->hash ^= ZOBRIST.traps[hashPlaceIndex(location)][numTraps];
+	gv->hash ^= ZOBRIST.traps[hashPlaceIndex(location)][numTraps - 1];
+	
 	placesDelete(gv->trapLocations, gv->numActiveTraps, location);
 	gv->numActiveTraps--;
 }
@@ -466,7 +594,115 @@ static void processRemoveTrap(GameView gv, PlaceId location) {
  * Deals a given amount of damage to the given player
  */
 static void processPlayerDamage(GameView gv, Player player, int amount) {
-	gv->playerHealth[player] = max(0, gv->playerHealth[player] - amount);
+	setPlayerHealth(gv, player, max(0, gv->playerHealth[player] - amount));
+}
+
+/////////////////////
+// Hashed state
+
+/**
+ * Fills in the Zobrist keys. The generator is seeded with a constant so
+ * that hashes are the same in every process.
+ */
+static void initZobristKeys(void) {
+	uint64_t seed = 0x9E3779B97F4A7C15;
+	uint64_t *keys = (uint64_t *) &ZOBRIST;
+	int numKeys = sizeof(ZOBRIST) / sizeof(uint64_t);
+	for (int i = 0; i < numKeys; i++) {
+		// splitmix64
+		uint64_t z = (seed += 0x9E3779B97F4A7C15);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+		keys[i] = z ^ (z >> 31);
+	}
+	
+	// Having no traps at a place contributes nothing
+	for (int i = 0; i < NUM_HASH_PLACES; i++) {
+		ZOBRIST.traps[i][0] = 0;
+	}
+}
+
+static int hashPlaceIndex(PlaceId place) {
+	if (placeIsReal(place)) {
+		return place;
+	} else if (place >= CITY_UNKNOWN && place <= TELEPORT) {
+		return NUM_REAL_PLACES + (place - CITY_UNKNOWN);
+	} else {
+		return NUM_HASH_PLACES - 1;
+	}
+}
+
+static int healthBucket(Player player, int health) {
+	if (player == PLAYER_DRACULA) {
+		health /= DRACULA_HEALTH_BUCKET_SIZE;
+	}
+	return min(health, NUM_HEALTH_BUCKETS - 1);
+}
+
+/**
+ * Hash of Dracula's trail after he has made the given number of moves
+ */
+static uint64_t trailHash(GameView gv, int numDraculaMoves) {
+	uint64_t hash = 0;
+	for (int age = 0; age < TRAIL_SIZE && age < numDraculaMoves; age++) {
+		PlaceId move = gv->moveHistory[PLAYER_DRACULA][numDraculaMoves - 1 - age];
+		hash ^= ZOBRIST.trail[age][hashPlaceIndex(move)];
+	}
+	return hash;
+}
+
+static uint64_t hashFromScratch(GameView gv) {
+	uint64_t hash = 0;
+	for (int p = 0; p < NUM_PLAYERS; p++) {
+		hash ^= ZOBRIST.location[p][hashPlaceIndex(gv->playerLocations[p])];
+		hash ^= ZOBRIST.health[p][healthBucket(p, gv->playerHealth[p])];
+	}
+	
+	// Dracula moves last, so he has made one move per completed round
+	hash ^= trailHash(gv, gv->round);
+	
+	for (int i = 0; i < gv->numActiveTraps; i++) {
+		// Each trap at a place moves its key from count n to n + 1
+		PlaceId location = gv->trapLocations[i];
+		int n = 0;
+		for (int j = 0; j < i; j++) {
+			if (gv->trapLocations[j] == location) n++;
+		}
+		hash ^= ZOBRIST.traps[hashPlaceIndex(location)][n];
+		hash ^= ZOBRIST.traps[hashPlaceIndex(location)][n + 1];
+	}
+	
+	hash ^= ZOBRIST.vampire[hashPlaceIndex(gv->vampireLocation)];
+	hash ^= ZOBRIST.player[gv->currentPlayer];
+	hash ^= ZOBRIST.railPhase[gv->round % 4];
+	return hash;
+}
+
+static int numTrapsAt(GameView gv, PlaceId location) {
+	int numTraps = 0;
+	for (int i = 0; i < gv->numActiveTraps; i++) {
+		if (gv->trapLocations[i] == location) numTraps++;
+	}
+	return numTraps;
+}
+
+static void setPlayerLocation(GameView gv, Player player,
+                              PlaceId location) {
+	gv->hash ^= ZOBRIST.location[player][hashPlaceIndex(gv->playerLocations[player])];
+	gv->playerLocations[player] = location;
+	gv->hash ^= ZOBRIST.location[player][hashPlaceIndex(location)];
+}
+
+static void setPlayerHealth(GameView gv, Player player, int health) {
+	gv->hash ^= ZOBRIST.health[player][healthBucket(player, gv->playerHealth[player])];
+	gv->playerHealth[player] = health;
+	gv->hash ^= ZOBRIST.health[player][healthBucket(player, health)];
+}
+
+static void setVampireLocation(GameView gv, PlaceId location) {
+	gv->hash ^= ZOBRIST.vampire[hashPlaceIndex(gv->vampireLocation)];
+	gv->vampireLocation = location;
+	gv->hash ^= ZOBRIST.vampire[hashPlaceIndex(location)];
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -477,6 +713,8 @@ void GvFree(GameView gv)
 		free(gv->moveHistory[i]);
 	}
 	free(gv->draculaLocationHistory);
+	free(gv->draculaActionHistory);
+	free(gv->undoStack);
 	MapFree(gv->map);
 	free(gv);
 }
@@ -518,7 +756,7 @@ PlaceId *GvGetTrapLocations(GameView gv, int *numTraps)
 {
 	// This just copies gv->trapLocations
 	*numTraps = gv->numActiveTraps;
-	PlaceId *trapLocations = malloc(*numTraps * sizeof(PlaceId));
+	PlaceId *trapLocations = ArenaAllocResult(*numTraps * sizeof(PlaceId));
 	placesCopy(trapLocations, gv->trapLocations, *numTraps);
 	return trapLocations;
 }
@@ -592,14 +830,6 @@ PlaceId *GvGetLastLocations(GameView gv, Player player, int numLocs,
 ////////////////////////////////////////////////////////////////////////
 // Making a Move
 
-static bool isForbiddenMove(Player player, PlaceId place);
-static void addRoadConnections(Map map, Player player, PlaceId from,
-                               bool *locations);
-static void addRailConnections(Map map, Player player, PlaceId from,
-                               bool *locations, int maxHops);
-static void addBoatConnections(Map map, Player player, PlaceId from,
-                               bool *locations);
-
 PlaceId *GvGetReachable(GameView gv, Player player, Round round,
                         PlaceId from, int *numReturnedLocs)
 {
@@ -611,81 +841,257 @@ PlaceId *GvGetReachableByType(GameView gv, Player player, Round round,
                               PlaceId from, bool road, bool rail,
                               bool boat, int *numReturnedLocs)
 {
-	bool locations[NUM_REAL_PLACES] = {};
-	locations[from] = true;
+	PlaceSet reachable = GvGetReachableSet(gv, player, round, from,
+	                                       road, rail, boat);
+	return placeSetToPlaces(reachable, numReturnedLocs);
+}
+
+PlaceSet GvGetReachableSet(GameView gv, Player player, Round round,
+                           PlaceId from, bool road, bool rail, bool boat)
+{
+	PlaceSet reachable = placeSetOf(from);
 	
 	if (road) {
-		addRoadConnections(gv->map, player, from, locations);
+		reachable = placeSetUnion(reachable,
+		                          MapGetNeighbourSet(gv->map, from, ROAD));
 	}
-	if (rail) {
+	if (rail && player != PLAYER_DRACULA) {
 		int maxHops = (player + round) % 4;
-		addRailConnections(gv->map, player, from, locations, maxHops);
+		reachable = placeSetUnion(reachable,
+		                          MapGetRailSet(gv->map, from, maxHops));
 	}
 	if (boat) {
-		addBoatConnections(gv->map, player, from, locations);
+		reachable = placeSetUnion(reachable,
+		                          MapGetNeighbourSet(gv->map, from, BOAT));
 	}
 	
-	return boolsToPlaces(locations, numReturnedLocs);
+	// Dracula can't go to the hospital (he can't be there already)
+	if (player == PLAYER_DRACULA && from != ST_JOSEPH_AND_ST_MARY) {
+		placeSetRemove(&reachable, ST_JOSEPH_AND_ST_MARY);
+	}
+	return reachable;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Helper functions
+
+static int max(int num1, int num2) {
+	return (num1 > num2 ? num1 : num2);
 }
 
-static bool isForbiddenMove(Player player, PlaceId place) {
-	return (player == PLAYER_DRACULA && place == ST_JOSEPH_AND_ST_MARY);
+static int min(int num1, int num2) {
+	return (num1 < num2 ? num1 : num2);
 }
 
-static void addRoadConnections(Map map, Player player, PlaceId from,
-                               bool *locations) {
-	ConnList curr = MapGetConnections(map, from);
-	for (; curr != NULL; curr = curr->next) {
-		if (curr->type == ROAD) {
-			if (!isForbiddenMove(player, curr->p)) {
-				locations[curr->p] = true;
-			}
+////////////////////////////////////////////////////////////////////////
+// Your own interface functions
+
+void GvMakeMove(GameView gv, const char play[8])
+{
+	if (gv->undoDepth == gv->undoCapacity) {
+		gv->undoCapacity = max(gv->undoCapacity * 2, 64);
+		gv->undoStack = realloc(gv->undoStack,
+		                        gv->undoCapacity * sizeof(Undo));
+		if (gv->undoStack == NULL) {
+			fprintf(stderr, "Insufficient memory!\n");
+			exit(EXIT_FAILURE);
 		}
 	}
+	
+	Undo *undo = &gv->undoStack[gv->undoDepth++];
+	undo->round = gv->round;
+	undo->currentPlayer = gv->currentPlayer;
+	undo->score = gv->score;
+	memcpy(undo->playerHealth, gv->playerHealth, sizeof(gv->playerHealth));
+	undo->moverLocation = gv->playerLocations[gv->currentPlayer];
+	placesCopy(undo->trapLocations, gv->trapLocations, gv->numActiveTraps);
+	undo->numActiveTraps = gv->numActiveTraps;
+	undo->vampireLocation = gv->vampireLocation;
+	undo->restAttempted = gv->restAttempted;
+	undo->hash = gv->hash;
+	
+	GvApplyPlay(gv, play);
+}
+
+void GvUnmakeMove(GameView gv)
+{
+	assert(gv->undoDepth > 0);
+	
+	Undo *undo = &gv->undoStack[--gv->undoDepth];
+	gv->round = undo->round;
+	gv->currentPlayer = undo->currentPlayer;
+	gv->score = undo->score;
+	memcpy(gv->playerHealth, undo->playerHealth, sizeof(gv->playerHealth));
+	gv->playerLocations[gv->currentPlayer] = undo->moverLocation;
+	placesCopy(gv->trapLocations, undo->trapLocations, undo->numActiveTraps);
+	gv->numActiveTraps = undo->numActiveTraps;
+	gv->vampireLocation = undo->vampireLocation;
+	gv->restAttempted = undo->restAttempted;
+	gv->hash = undo->hash;
 }
 
-static void addRailConnections(Map map, Player player, PlaceId from,
-                               bool *locations, int maxHops) {
-    locations[from] = true;
-    if (maxHops <= 0 || player == PLAYER_DRACULA) {
-        return;
-    }
-    
-    ConnList curr = MapGetConnections(map, from);
-    for (; curr != NULL; curr = curr->next) {
-        if (curr->type == RAIL) {
-            if (!isForbiddenMove(player, from)) {
-	            addRailConnections(map, player, curr->p, locations,
-	                               maxHops - 1);
-            }
-        }
-    }
-}
-
-static void addBoatConnections(Map map, Player player, PlaceId from,
-                               bool *locations) {
-    ConnList curr = MapGetConnections(map, from);
-    for (; curr != NULL; curr = curr->next) {
-        if (curr->type == BOAT) {
-			if (!isForbiddenMove(player, from)) {
-				locations[curr->p] = true;
+void GvCloneInto(GameView dst, GameView src)
+{
+	// State
+	dst->round = src->round;
+	dst->currentPlayer = src->currentPlayer;
+	dst->score = src->score;
+	memcpy(dst->playerHealth, src->playerHealth, sizeof(src->playerHealth));
+	memcpy(dst->playerLocations, src->playerLocations,
+	       sizeof(src->playerLocations));
+	placesCopy(dst->trapLocations, src->trapLocations, src->numActiveTraps);
+	dst->numActiveTraps = src->numActiveTraps;
+	dst->vampireLocation = src->vampireLocation;
+	dst->restAttempted = src->restAttempted;
+	dst->hash = src->hash;
+	
+	// History - only the rounds that have actually been played
+	int numRounds = src->round + 1;
+	ensureHistoryCapacity(dst, numRounds);
+	for (int i = 0; i < NUM_PLAYERS; i++) {
+		placesCopy(dst->moveHistory[i], src->moveHistory[i], numRounds);
+	}
+	placesCopy(dst->draculaLocationHistory, src->draculaLocationHistory,
+	           numRounds);
+	memcpy(dst->draculaActionHistory, src->draculaActionHistory,
+	       numRounds * sizeof(unsigned char));
+	
+	// The clone starts a fresh search
+	dst->undoDepth = 0;
+}
+
+uint64_t GvGetHash(GameView gv)
+{
+	return gv->hash;
+}
+
+void GvDeterminise(GameView gv, const PlaceId locations[],
+                   int numLocations)
+{
+	for (int i = 0; i < numLocations && gv->round - 1 - i >= 0; i++) {
+		Round r = gv->round - 1 - i;
+		PlaceId hidden = gv->draculaLocationHistory[r];
+		if (hidden != CITY_UNKNOWN && hidden != SEA_UNKNOWN) continue;
+		
+		PlaceId location = locations[i];
+		gv->draculaLocationHistory[r] = location;
+		if (gv->moveHistory[PLAYER_DRACULA][r] == hidden) {
+			gv->moveHistory[PLAYER_DRACULA][r] = location;
+		}
+		
+		// Whatever he left behind is there too, unless a hunter has
+		// already dealt with it
+		for (int t = 0; (gv->draculaActionHistory[r] & LEFT_TRAP) &&
+		                t < gv->numActiveTraps; t++) {
+			if (gv->trapLocations[t] == CITY_UNKNOWN) {
+				gv->trapLocations[t] = location;
+				break;
 			}
 		}
-    }
+		if ((gv->draculaActionHistory[r] & LEFT_VAMPIRE) &&
+		    gv->vampireLocation == CITY_UNKNOWN) {
+			gv->vampireLocation = location;
+		}
+	}
+	
+	if (gv->round > 0) {
+		gv->playerLocations[PLAYER_DRACULA] =
+			gv->draculaLocationHistory[gv->round - 1];
+	}
+	gv->hash = hashFromScratch(gv);
 }
 
-////////////////////////////////////////////////////////////////////////
-// Helper functions
+static void buildDraculaActions(GameView gv, PlaceId move, char *actions);
+static void buildHunterActions(GameView gv, PlaceId move, char *actions);
+static bool trapStillActive(GameView gv, Round placed);
 
-static int max(int num1, int num2) {
-	return (num1 > num2 ? num1 : num2);
+void GvBuildPlay(GameView gv, PlaceId move, char play[8])
+{
+	const char *abbrev = placeIdToAbbrev(move);
+	memset(play, '.', 7);
+	play[7] = '\0';
+	play[0] = "GSHMD"[gv->currentPlayer];
+	play[1] = abbrev[0];
+	play[2] = abbrev[1];
+	
+	if (gv->currentPlayer == PLAYER_DRACULA) {
+		buildDraculaActions(gv, move, &play[3]);
+	} else {
+		buildHunterActions(gv, move, &play[3]);
+	}
 }
 
-static int min(int num1, int num2) {
-	return (num1 < num2 ? num1 : num2);
+/**
+ * Works out what Dracula leaves behind, and what drops off the end of
+ * his trail, if he makes the given move
+ */
+static void buildDraculaActions(GameView gv, PlaceId move, char *actions) {
+	PlaceId location = resolveDraculaMove(gv, move);
+	
+	// Whatever drops off the end of the trail goes first, and frees up
+	// a spot if it was at the place Dracula is moving to
+	int encounters = numTrapsAt(gv, location) +
+	                 (gv->vampireLocation == location);
+	Round old = gv->round - TRAIL_SIZE;
+	if (old >= 0) {
+		if ((gv->draculaActionHistory[old] & LEFT_VAMPIRE) &&
+		    gv->vampireLocation != NOWHERE) {
+			actions[2] = 'V';
+		} else if ((gv->draculaActionHistory[old] & LEFT_TRAP) &&
+		           trapStillActive(gv, old)) {
+			actions[2] = 'M';
+		}
+		if (actions[2] != '.' &&
+		    gv->draculaLocationHistory[old] == location) {
+			encounters--;
+		}
+	}
+	
+	// A city can't hold more than three encounters, vampire included
+	if (placeIsLand(location) && encounters < 3) {
+		if (gv->round % VAMPIRE_ROUNDS == 0) {
+			actions[1] = 'V';
+		} else {
+			actions[0] = 'T';
+		}
+	}
 }
 
-////////////////////////////////////////////////////////////////////////
-// Your own interface functions
+/**
+ * Works out what the current hunter encounters if they move to the
+ * given place: traps, then the vampire, then Dracula, stopping if the
+ * hunter runs out of life points
+ */
+static void buildHunterActions(GameView gv, PlaceId move, char *actions) {
+	int health = gv->playerHealth[gv->currentPlayer];
+	int n = 0;
+	for (int i = numTrapsAt(gv, move); i > 0 && health > 0 && n < 4; i--) {
+		actions[n++] = 'T';
+		health -= LIFE_LOSS_TRAP_ENCOUNTER;
+	}
+	if (health > 0 && n < 4 && gv->vampireLocation == move) {
+		actions[n++] = 'V';
+	}
+	if (health > 0 && n < 4 && placeIsLand(move) &&
+	    gv->playerLocations[PLAYER_DRACULA] == move) {
+		actions[n++] = 'D';
+	}
+}
 
-// TODO
+/**
+ * Checks whether the trap Dracula placed in the given round hasn't been
+ * set off yet. Traps at the same place are interchangeable, so it is
+ * still there if there are more traps at that place than he has placed
+ * there since.
+ */
+static bool trapStillActive(GameView gv, Round placed) {
+	PlaceId location = gv->draculaLocationHistory[placed];
+	int newer = 0;
+	for (Round r = placed + 1; r < gv->round; r++) {
+		if ((gv->draculaActionHistory[r] & LEFT_TRAP) &&
+		    gv->draculaLocationHistory[r] == location) {
+			newer++;
+		}
+	}
+	return numTrapsAt(gv, location) > newer;
+}
@@ -21,6 +21,9 @@
 #include "Game.h"
 #include "Places.h"
 // add your own #includes here
+#include <stdint.h>
+
+#include "PlaceSet.h"
 
 typedef struct gameView *GameView;
 
@@ -254,6 +257,79 @@ PlaceId *GvGetReachableByType(GameView gv, Player player, Round round,
 ////////////////////////////////////////////////////////////////////////
 // Your own interface functions
 
-// TODO
+/**
+ * Like GvGetReachableByType, but returns the places as a PlaceSet.  The
+ * per-place  connection  sets are precomputed, so this is just a few OR
+ * operations and doesn't allocate anything.
+ */
+PlaceSet GvGetReachableSet(GameView gv, Player player, Round round,
+                           PlaceId from, bool road, bool rail, bool boat);
+
+/**
+ * Advances the game view by a single play, exactly as if the play  had
+ * been appended to the pastPlays string given to GvNew.
+ *
+ * `play`  must  point to the 7 characters of one play (e.g. "GMN....");
+ * anything after them is ignored, so it is fine to pass a pointer  into
+ * the middle of a pastPlays string. This is O(1), so a long-lived  view
+ * can be kept up to date for a whole game without being rebuilt.
+ */
+void GvApplyPlay(GameView gv, const char play[8]);
+
+/**
+ * Like GvApplyPlay, but also records what the play changed so that  it
+ * can  be  taken  back  with GvUnmakeMove. Moves are undone in the same
+ * order as a stack. Intended for tree searches: once the undo stack and
+ * history arrays have grown to the search depth, making and  unmaking
+ * moves does not allocate.
+ */
+void GvMakeMove(GameView gv, const char play[8]);
+
+/**
+ * Takes back the most recent GvMakeMove.
+ */
+void GvUnmakeMove(GameView gv);
+
+/**
+ * Copies the game state and history of `src` into `dst`, which must be
+ * an existing view (e.g. one returned by GvNew("", NULL)) owned by  the
+ * caller.  `dst`  keeps its own buffers and only reallocates them if it
+ * has not yet seen a game as long as `src`. The undo stack of `dst`  is
+ * cleared.
+ */
+void GvCloneInto(GameView dst, GameView src);
+
+/**
+ * Gets  a 64-bit Zobrist hash of the game state, suitable for use as  a
+ * transposition table key. Two views have the same hash if the players
+ * are  in  the  same places with the same (bucketed) health, Dracula's
+ * trail, traps and vampire are the same, and it is the  same  player's
+ * turn in a round with the same rail allowance, regardless of how  the
+ * game got there. The hash is kept up to date as plays are applied, so
+ * this is O(1).
+ */
+uint64_t GvGetHash(GameView gv);
+
+/**
+ * Writes  the  full  play  string  (e.g. "GCDTD..")  for  the  current
+ * player  making  the  given move, including everything the move sets
+ * off: a hunter's encounters with traps, the vampire and Dracula, and
+ * the trap or vampire Dracula leaves behind and whatever drops off the
+ * end  of  his trail. Dracula's move can be HIDE, DOUBLE_BACK_n or
+ * TELEPORT. This is how the game engine would report the move to a view
+ * that can see everything, so the result can be given to GvMakeMove.
+ */
+void GvBuildPlay(GameView gv, PlaceId move, char play[8]);
+
+/**
+ * Fills  in  where  Dracula  was for his last numLocations moves, from
+ * locations[0] (his latest move) back. Only moves the view doesn't know
+ * (CITY_UNKNOWN or SEA_UNKNOWN) are changed, along with any trap or
+ * vampire he left there. This turns a hunter's view into one possible
+ * full view of the game (a determinisation), for searching ahead; the
+ * locations should be consistent with what the hunters have seen.
+ */
+void GvDeterminise(GameView gv, const PlaceId locations[],
+                   int numLocations);
 
 #endif // !defined (FOD__GAME_VIEW_H_)
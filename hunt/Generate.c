@@ -0,0 +1,294 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// Generate.c: random legal games
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "DraculaView.h"
+#include "Game.h"
+#include "Generate.h"
+#include "GameView.h"
+#include "Map.h"
+#include "PlaceSet.h"
+#include "Places.h"
+#include "Random.h"
+#include "Rollout.h"
+
+// Each play is 7 characters, and plays are separated by spaces
+#define PLAY_LENGTH 7
+#define PLAY_SIZE   (PLAY_LENGTH + 1)
+
+static PlaceId uniformDraculaMove(DraculaView dv, Random *rng);
+static PlaceId uniformHunterMove(DraculaView dv, Random *rng);
+static PlaceId cautiousDraculaMove(DraculaView dv, Random *rng);
+static PlaceId cautiousHunterMove(DraculaView dv, Random *rng);
+static PlaceId randomCity(Random *rng);
+static PlaceId randomPlace(PlaceSet places, Random *rng);
+static void revealTrail(const PlaceId locs[], bool revealed[], int play,
+                        PlaceId location);
+
+PlaceId generateMove(DraculaView dv, const GenerateOptions *options,
+                     Random *rng)
+{
+	GameView gv = DvGetGameView(dv);
+	Player player = GvGetPlayer(gv);
+	GeneratePolicy policy = (player == PLAYER_DRACULA) ? options->dracula
+	                                                   : options->hunters;
+	if (policy == GENERATE_SCRIPTED) {
+		PlaceId move = options->script(dv, options->scriptArg);
+		if (move != NOWHERE) return move;
+		policy = GENERATE_UNIFORM;
+	}
+	if (!placeIsReal(GvGetPlayerLocation(gv, player))) {
+		return randomCity(rng);
+	}
+	
+	switch (policy) {
+		case GENERATE_GREEDY:
+			return (player == PLAYER_DRACULA) ? rolloutDraculaMove(dv, rng)
+			                                  : rolloutHunterMove(dv, rng);
+		case GENERATE_CAUTIOUS:
+			return (player == PLAYER_DRACULA) ? cautiousDraculaMove(dv, rng)
+			                                  : cautiousHunterMove(dv, rng);
+		default:
+			return (player == PLAYER_DRACULA) ? uniformDraculaMove(dv, rng)
+			                                  : uniformHunterMove(dv, rng);
+	}
+}
+
+int generatePlays(DraculaView dv, const GenerateOptions *options,
+                  int numPlays, Random *rng, char *plays)
+{
+	GameView gv = DvGetGameView(dv);
+	int numMade = 0;
+	while (numMade < numPlays && (options->pastEnd || !rolloutIsOver(dv))) {
+		char *play = &plays[numMade * PLAY_SIZE];
+		GvBuildPlay(gv, generateMove(dv, options, rng), play);
+		DvApplyPlay(dv, play);
+		play[PLAY_LENGTH] = ' ';
+		numMade++;
+	}
+	plays[(numMade > 0) ? numMade * PLAY_SIZE - 1 : 0] = '\0';
+	return numMade;
+}
+
+char *generateGame(const GenerateOptions *options, int numRounds,
+                   Random *rng, int *numPlays)
+{
+	int maxPlays = numRounds * NUM_PLAYERS;
+	char *pastPlays = malloc(maxPlays * PLAY_SIZE + 1);
+	if (pastPlays == NULL) {
+		fprintf(stderr, "Couldn't allocate pastPlays\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	DraculaView dv = DvNew("", NULL);
+	*numPlays = generatePlays(dv, options, maxPlays, rng, pastPlays);
+	DvFree(dv);
+	return pastPlays;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Policies
+
+static PlaceId uniformDraculaMove(DraculaView dv, Random *rng) {
+	PlaceId moves[NUM_REAL_PLACES];
+	int numMoves = DvFillValidMoves(dv, moves);
+	return (numMoves > 0) ? moves[randomBelow(rng, numMoves)] : TELEPORT;
+}
+
+static PlaceId uniformHunterMove(DraculaView dv, Random *rng) {
+	GameView gv = DvGetGameView(dv);
+	Player hunter = GvGetPlayer(gv);
+	PlaceId from = GvGetPlayerLocation(gv, hunter);
+	return randomPlace(GvGetReachableSet(gv, hunter, GvGetRound(gv), from,
+	                                     true, true, true), rng);
+}
+
+static PlaceId cautiousDraculaMove(DraculaView dv, Random *rng) {
+	PlaceId moves[NUM_REAL_PLACES];
+	int numMoves = DvFillValidMoves(dv, moves);
+	PlaceId safe[NUM_REAL_PLACES];
+	int numSafe = 0;
+	for (int i = 0; i < numMoves; i++) {
+		PlaceId location = DvResolveMove(dv, moves[i]);
+		bool ok = placeIsLand(location);
+		for (Player p = 0; ok && p < PLAYER_DRACULA; p++) {
+			ok = DvGetPlayerLocation(dv, p) != location;
+		}
+		if (ok) safe[numSafe++] = moves[i];
+	}
+	
+	return (numSafe > 0) ? safe[randomBelow(rng, numSafe)]
+	                     : rolloutDraculaMove(dv, rng);
+}
+
+static PlaceId cautiousHunterMove(DraculaView dv, Random *rng) {
+	GameView gv = DvGetGameView(dv);
+	Player hunter = GvGetPlayer(gv);
+	Round round = GvGetRound(gv);
+	PlaceId from = GvGetPlayerLocation(gv, hunter);
+	PlaceSet reachable = GvGetReachableSet(gv, hunter, round, from,
+	                                       true, true, true);
+	PlaceId dracula = GvGetPlayerLocation(gv, PLAYER_DRACULA);
+	if (placeIsReal(dracula)) placeSetRemove(&reachable, dracula);
+	
+	// Whoever can get to the vampire first goes for it
+	PlaceId vampire = GvGetVampireLocation(gv);
+	if (placeIsReal(vampire)) {
+		Map map = MapNew();
+		int phase = (hunter + round + 1) % MAP_NUM_RAIL_PHASES;
+		int dist = MapGetHunterDistance(map, phase, from, vampire);
+		bool nearest = true;
+		for (Player p = 0; nearest && p < PLAYER_DRACULA; p++) {
+			PlaceId other = GvGetPlayerLocation(gv, p);
+			if (p == hunter || !placeIsReal(other)) continue;
+			int otherDist = MapGetHunterDistance(map, phase, other, vampire);
+			nearest = otherDist > dist || (otherDist == dist && p > hunter);
+		}
+		if (nearest) {
+			PlaceId best = from;
+			for (PlaceId p; (p = placeSetPop(&reachable)) != NOWHERE; ) {
+				int d = MapGetHunterDistance(map, phase, p, vampire);
+				if (d < dist) {
+					dist = d;
+					best = p;
+				}
+			}
+			return best;
+		}
+	}
+	
+	int numTraps = 0;
+	PlaceId *traps = GvGetTrapLocations(gv, &numTraps);
+	PlaceSet safe = reachable;
+	for (int i = 0; i < numTraps; i++) {
+		placeSetRemove(&safe, traps[i]);
+	}
+	free(traps);
+	
+	if (!placeSetIsEmpty(safe)) return randomPlace(safe, rng);
+	if (!placeSetIsEmpty(reachable)) return randomPlace(reachable, rng);
+	return from;
+}
+
+/** A random city that isn't the hospital */
+static PlaceId randomCity(Random *rng) {
+	PlaceId p;
+	do {
+		p = randomBelow(rng, NUM_REAL_PLACES);
+	} while (!placeIsLand(p) || p == HOSPITAL_PLACE);
+	return p;
+}
+
+static PlaceId randomPlace(PlaceSet places, Random *rng) {
+	PlaceId array[NUM_REAL_PLACES];
+	int numPlaces = placeSetToArray(places, array);
+	return array[randomBelow(rng, numPlaces)];
+}
+
+////////////////////////////////////////////////////////////////////////
+// What the hunters can see
+
+void generateHunterPlays(GameView gv, const char *pastPlays,
+                         char *hunterPlays)
+{
+	int length = strlen(pastPlays);
+	int numPlays = (length + 1) / PLAY_SIZE;
+	int numLocs = 0;
+	bool canFree = false;
+	PlaceId *locs = GvGetLocationHistory(gv, PLAYER_DRACULA, &numLocs,
+	                                     &canFree);
+	
+	bool *revealed = calloc(numLocs + 1, sizeof(bool));
+	if (revealed == NULL) {
+		fprintf(stderr, "Couldn't allocate hunterPlays\n");
+		exit(EXIT_FAILURE);
+	}
+	PlaceId hunterLocs[PLAYER_DRACULA] = {
+		NOWHERE, NOWHERE, NOWHERE, NOWHERE
+	};
+	for (int i = 0; i < numPlays; i++) {
+		const char *play = &pastPlays[i * PLAY_SIZE];
+		Player player = i % NUM_PLAYERS;
+		Round round = i / NUM_PLAYERS;
+		if (player == PLAYER_DRACULA) {
+			for (Player p = 0; p < PLAYER_DRACULA; p++) {
+				if (hunterLocs[p] == locs[round] &&
+				    !placeIsSea(locs[round])) {
+					revealed[round] = true;
+				}
+			}
+			continue;
+		}
+		
+		char abbrev[3] = { play[1], play[2], '\0' };
+		PlaceId location = placeAbbrevToId(abbrev);
+		bool encounter = false;
+		for (int j = 3; j < PLAY_LENGTH; j++) {
+			encounter = encounter || play[j] == 'T' || play[j] == 'V'
+			                      || play[j] == 'D';
+		}
+		if (encounter) {
+			revealTrail(locs, revealed, i, location);
+		}
+		
+		hunterLocs[player] = location;
+		if (player == PLAYER_MINA_HARKER && round >= TRAIL_SIZE) {
+			bool research = true;
+			for (int p = 0; p < PLAYER_DRACULA; p++) {
+				const char *prev = &pastPlays[(i - p - NUM_PLAYERS)
+				                              * PLAY_SIZE];
+				const char *curr = &pastPlays[(i - p) * PLAY_SIZE];
+				research = research && prev[1] == curr[1]
+				                    && prev[2] == curr[2];
+			}
+			if (research) revealed[round - TRAIL_SIZE] = true;
+		}
+	}
+	
+	if (hunterPlays != pastPlays) memcpy(hunterPlays, pastPlays, length + 1);
+	for (Round r = 0; r < numLocs; r++) {
+		char *play = &hunterPlays[(r * NUM_PLAYERS + PLAYER_DRACULA)
+		                          * PLAY_SIZE];
+		char abbrev[3] = { play[1], play[2], '\0' };
+		PlaceId move = placeAbbrevToId(abbrev);
+		
+		bool shown;
+		if (move == HIDE) {
+			shown = locs[r] == CASTLE_DRACULA || revealed[r]
+			     || revealed[r - 1]
+			     || numLocs - 1 >= r - 1 + TRAIL_SIZE;
+		} else if (placeIsReal(move)) {
+			shown = move == CASTLE_DRACULA || revealed[r];
+		} else {
+			shown = true;
+		}
+		
+		if (!shown) {
+			const char *hidden = placeIsSea(locs[r]) ? "S?" : "C?";
+			play[1] = hidden[0];
+			play[2] = hidden[1];
+		}
+	}
+	
+	if (canFree) free(locs);
+	free(revealed);
+}
+
+/**
+ * Reveals each of Dracula's moves to `location` that were still in his
+ * trail when the given play was made
+ */
+static void revealTrail(const PlaceId locs[], bool revealed[], int play,
+                        PlaceId location) {
+	Round latest = play / NUM_PLAYERS - 1;
+	for (Round r = latest; r >= 0 && r > latest - TRAIL_SIZE; r--) {
+		if (locs[r] == location) revealed[r] = true;
+	}
+}
@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// Generate.h: random legal games
+//
+// Plays games forward from any position (usually the start), choosing
+// everyone's moves with a policy for Dracula and one for the hunters,
+// and writes each play out the way the game engine would report it,
+// encounters and all (see GvBuildPlay). So every game is a legal
+// pastPlays string, as Dracula sees it; generateHunterPlays hides his
+// moves the way the referee does, for the hunters' side.
+//
+// The policies are:
+// - GENERATE_UNIFORM: any legal move, all equally likely.
+// - GENERATE_GREEDY: the rollout policies (see Rollout.h): the hunters
+//   mostly head for Dracula, and he keeps away from them.
+// - GENERATE_CAUTIOUS: everyone keeps out of trouble, so games tend to
+//   go on until the score runs out. Dracula keeps to land and away from
+//   the hunters; the hunters keep clear of him and his traps, except
+//   that whoever is nearest a vampire goes to get rid of it.
+// - GENERATE_SCRIPTED: the caller's function chooses. Where it returns
+//   NOWHERE, the move is chosen as for GENERATE_UNIFORM.
+// Each player's first move is to a random city (not the hospital),
+// except when scripted. Dracula makes a TELEPORT when he has no other
+// move, whatever the policy.
+//
+// The moves are made on a DraculaView, and the random numbers come from
+// the caller's generator (see Random.h), so a seed always gives the
+// same game.
+// Apart from generateGame's result and generateHunterPlays' scratch,
+// nothing allocates, except GENERATE_CAUTIOUS hunters asking where the
+// traps are.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+
+#include "DraculaView.h"
+#include "Game.h"
+#include "GameView.h"
+#include "Places.h"
+#include "Random.h"
+
+#ifndef FOD__GENERATE_H_
+#define FOD__GENERATE_H_
+
+/** How moves are chosen (see above). */
+typedef enum generatePolicy {
+	GENERATE_UNIFORM,
+	GENERATE_GREEDY,
+	GENERATE_CAUTIOUS,
+	GENERATE_SCRIPTED,
+} GeneratePolicy;
+
+/**
+ * Chooses a move for the player whose turn it is in `dv`, or returns
+ * NOWHERE to leave it to GENERATE_UNIFORM. The move must be legal.
+ */
+typedef PlaceId (*GenerateScript)(DraculaView dv, void *arg);
+
+typedef struct generateOptions {
+	GeneratePolicy dracula;
+	GeneratePolicy hunters;
+	GenerateScript script;    // for GENERATE_SCRIPTED
+	void          *scriptArg; // given to the script
+	bool           pastEnd;   // whether to keep playing after the game
+	                          // is over
+} GenerateOptions;
+
+/**
+ * Chooses a move for the player whose turn it is in `dv` (a full view
+ * of the game).
+ */
+PlaceId generateMove(DraculaView dv, const GenerateOptions *options,
+                     Random *rng);
+
+/**
+ * Makes up to numPlays plays from the position in `dv`, applying each
+ * one to it, until the game is over (unless options->pastEnd). Writes
+ * the plays to `plays`, separated by spaces and ending with '\0', which
+ * needs room for numPlays * 8 characters. Returns how many plays were
+ * made.
+ */
+int generatePlays(DraculaView dv, const GenerateOptions *options,
+                  int numPlays, Random *rng, char *plays);
+
+/**
+ * Plays a game of up to numRounds rounds from the start, and returns
+ * its pastPlays string, which the caller should free. Sets *numPlays
+ * to the number of plays in it.
+ */
+char *generateGame(const GenerateOptions *options, int numRounds,
+                   Random *rng, int *numPlays);
+
+/**
+ * Writes the given plays (a whole pastPlays string, as Dracula sees it)
+ * to hunterPlays as the hunters see them: his moves are shown as C? or
+ * S? unless they have found out where he was. They find out
+ * - always, if he was at Castle Dracula;
+ * - when one of them runs into him, or into a trap or vampire he left,
+ *   for each of his moves still in his trail to that place;
+ * - when he moves onto a city where one of them is;
+ * - when all four of them rest in the same round (research), for the
+ *   move at the end of his trail.
+ * HIDE is shown as C? while it would give away where he is, and
+ * DOUBLE_BACK and TELEPORT moves are always shown.
+ *
+ * `gv` must be a full view of the game after those plays. hunterPlays
+ * needs as much room as pastPlays, and can be the same string.
+ */
+void generateHunterPlays(GameView gv, const char *pastPlays,
+                         char *hunterPlays);
+
+#endif // !defined(FOD__GENERATE_H_)
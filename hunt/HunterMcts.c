@@ -0,0 +1,304 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// HunterMcts.c: information set Monte Carlo tree search for the hunters
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Decision.h"
+#include "DraculaView.h"
+#include "Game.h"
+#include "GameView.h"
+#include "HunterMcts.h"
+#include "HunterView.h"
+#include "Parallel.h"
+#include "PlaceSet.h"
+#include "Places.h"
+#include "Random.h"
+#include "Rollout.h"
+
+#define MAX_NODES       (1 << 16)
+#define MAX_DEPTH       64
+#define ROLLOUT_ROUNDS  8
+
+// UCB1 exploration constant
+#define EXPLORATION     0.7
+
+// How often (in iterations) to check the clock
+#define CLOCK_INTERVAL  16
+
+#define UNEXPANDED      (-1)
+
+typedef struct mctsNode {
+	PlaceId move;        // the hunter's move into this node
+	int     visits;
+	double  totalValue;  // from the hunters' side
+	int     firstChild;  // index of the first child in the pool
+	int     numChildren; // UNEXPANDED until the node is expanded
+} MctsNode;
+
+struct hunterMcts {
+	MctsNode   *nodes;   // node pool; the root is always nodes[0]
+	int         numNodes;
+	int         rootScore;
+	Random      rng;
+
+	// The sampled world each iteration plays in
+	DraculaView world;
+};
+
+static void iterate(HunterMcts hm, HunterView hv);
+static bool expand(HunterMcts hm, int node, PlaceSet moves);
+static int  selectChild(HunterMcts hm, int node, PlaceSet legal);
+static PlaceSet hunterMoves(DraculaView world);
+static int  searchShare(void *state, MctsMoveStats stats[]);
+
+////////////////////////////////////////////////////////////////////////
+// Constructor/Destructor
+
+HunterMcts HmNew(unsigned int seed)
+{
+	HunterMcts hm = malloc(sizeof(*hm));
+	if (hm == NULL) {
+		fprintf(stderr, "Couldn't allocate HunterMcts\n");
+		exit(EXIT_FAILURE);
+	}
+
+	hm->nodes = malloc(MAX_NODES * sizeof(MctsNode));
+	if (hm->nodes == NULL) {
+		fprintf(stderr, "Couldn't allocate HunterMcts\n");
+		exit(EXIT_FAILURE);
+	}
+
+	hm->numNodes = 0;
+	randomSeed(&hm->rng, seed);
+	hm->world = DvNew("", NULL);
+	return hm;
+}
+
+void HmFree(HunterMcts hm)
+{
+	DvFree(hm->world);
+	free(hm->nodes);
+	free(hm);
+}
+
+////////////////////////////////////////////////////////////////////////
+// Searching
+
+int HmSearch(HunterMcts hm, HunterView hv, int maxIterations)
+{
+	hm->nodes[0] = (MctsNode) {
+		.move = NOWHERE, .visits = 0, .totalValue = 0.0,
+		.firstChild = 0, .numChildren = UNEXPANDED,
+	};
+	hm->numNodes = 1;
+	hm->rootScore = HvGetScore(hv);
+
+	int n = 0;
+	while (maxIterations == 0 || n < maxIterations) {
+		if (n % CLOCK_INTERVAL == 0 && decisionTimeUp()) break;
+		iterate(hm, hv);
+		n++;
+	}
+	return n;
+}
+
+PlaceId HmBestMove(HunterMcts hm)
+{
+	if (hm->numNodes == 0 || hm->nodes[0].numChildren <= 0) {
+		return NOWHERE;
+	}
+
+	MctsNode *root = &hm->nodes[0];
+	MctsNode *best = &hm->nodes[root->firstChild];
+	for (int i = 1; i < root->numChildren; i++) {
+		MctsNode *child = &hm->nodes[root->firstChild + i];
+		if (child->visits > best->visits) {
+			best = child;
+		}
+	}
+	return best->move;
+}
+
+int HmGetRootStats(HunterMcts hm, MctsMoveStats stats[])
+{
+	if (hm->numNodes == 0 || hm->nodes[0].numChildren <= 0) {
+		return 0;
+	}
+
+	MctsNode *root = &hm->nodes[0];
+	for (int i = 0; i < root->numChildren; i++) {
+		MctsNode *child = &hm->nodes[root->firstChild + i];
+		stats[i].move = child->move;
+		stats[i].visits = child->visits;
+		stats[i].value = child->visits > 0
+		               ? child->totalValue / child->visits : 0.0;
+	}
+	return root->numChildren;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Searching on several threads
+
+// One thread's share of a parallel search, with its own copy of the view
+typedef struct searchShare {
+	HunterMcts hm;
+	HunterView hv;
+	int        maxIterations;
+} SearchShare;
+
+int HmSearchParallel(HunterView hv, unsigned int seed, int numThreads,
+                     int maxIterations, MctsMoveStats stats[])
+{
+	SearchShare shares[MAX_THREADS];
+	void *states[MAX_THREADS];
+	if (numThreads > MAX_THREADS) numThreads = MAX_THREADS;
+	for (int i = 0; i < numThreads; i++) {
+		shares[i] = (SearchShare) {
+			.hm = HmNew(parallelThreadSeed(seed, i)),
+			.hv = HvClone(hv),
+			.maxIterations = maxIterations,
+		};
+		states[i] = &shares[i];
+	}
+
+	int numMoves = parallelSearch(searchShare, states, numThreads, stats);
+	for (int i = 0; i < numThreads; i++) {
+		HmFree(shares[i].hm);
+		HvFree(shares[i].hv);
+	}
+	return numMoves;
+}
+
+static int searchShare(void *state, MctsMoveStats stats[]) {
+	SearchShare *share = state;
+	HmSearch(share->hm, share->hv, share->maxIterations);
+	return HmGetRootStats(share->hm, stats);
+}
+
+////////////////////////////////////////////////////////////////////////
+// One iteration: sample a world, select, expand, roll out, back up
+
+static void iterate(HunterMcts hm, HunterView hv) {
+	// A fresh copy of the game, with Dracula's hidden moves filled in.
+	// The copy is thrown away afterwards, so nothing needs undoing.
+	PlaceId trail[TRAIL_SIZE];
+	int trailLength = HvSampleDraculaTrail(hv, trail, &hm->rng);
+	if (trailLength == 0 && HvGetRound(hv) > 0) return;
+	DvCloneFrom(hm->world, HvGetGameView(hv));
+	DvDeterminise(hm->world, trail, trailLength);
+
+	DraculaView world = hm->world;
+	GameView gv = DvGetGameView(world);
+	int path[MAX_DEPTH + 1];
+	int depth = 0;
+	int node = 0;
+	path[0] = 0;
+	while (depth < MAX_DEPTH && !rolloutIsOver(world)) {
+		if (GvGetPlayer(gv) == PLAYER_DRACULA) {
+			DvMakeMove(world, rolloutDraculaMove(world, &hm->rng));
+			continue;
+		}
+
+		// A hunter sent to hospital in this world can't make the moves
+		// the node has from other worlds
+		PlaceSet legal = hunterMoves(world);
+		if (placeSetIsEmpty(legal)) break;
+		if (hm->nodes[node].numChildren == UNEXPANDED &&
+		    !expand(hm, node, legal)) {
+			break;
+		}
+
+		int child = selectChild(hm, node, legal);
+		if (child == UNEXPANDED) break;
+		node = child;
+		path[++depth] = node;
+		DvMakeMove(world, hm->nodes[node].move);
+		if (hm->nodes[node].visits == 0) break;
+	}
+
+	rolloutPlay(world, ROLLOUT_ROUNDS, &hm->rng);
+	double value = 1.0 - rolloutScore(world, hm->rootScore);
+	for (int i = 0; i <= depth; i++) {
+		hm->nodes[path[i]].visits++;
+		hm->nodes[path[i]].totalValue += value;
+	}
+}
+
+/**
+ * Gets the places the current hunter can move to (including staying
+ * put), or the empty set if they haven't made their first move
+ */
+static PlaceSet hunterMoves(DraculaView world) {
+	GameView gv = DvGetGameView(world);
+	Player hunter = GvGetPlayer(gv);
+	PlaceId from = GvGetPlayerLocation(gv, hunter);
+	if (!placeIsReal(from)) {
+		return PLACE_SET_EMPTY;
+	}
+	return GvGetReachableSet(gv, hunter, GvGetRound(gv), from,
+	                         true, true, true);
+}
+
+/**
+ * Gives the node a child for each of the given moves. Fails if the pool
+ * is full.
+ */
+static bool expand(HunterMcts hm, int node, PlaceSet moves) {
+	int numChildren = placeSetSize(moves);
+	if (hm->numNodes + numChildren > MAX_NODES) {
+		return false;
+	}
+
+	int first = hm->numNodes;
+	for (int i = 0; i < numChildren; i++) {
+		hm->nodes[first + i] = (MctsNode) {
+			.move = placeSetPop(&moves),
+			.visits = 0, .totalValue = 0.0,
+			.firstChild = 0, .numChildren = UNEXPANDED,
+		};
+	}
+	hm->numNodes += numChildren;
+	hm->nodes[node].firstChild = first;
+	hm->nodes[node].numChildren = numChildren;
+	return true;
+}
+
+/**
+ * Picks one of the node's children that is a legal move in this world,
+ * by UCB1, trying each child once first (in a random order). Returns
+ * UNEXPANDED if none of them are legal.
+ */
+static int selectChild(HunterMcts hm, int node, PlaceSet legal) {
+	MctsNode *parent = &hm->nodes[node];
+	double logVisits = log(parent->visits > 0 ? parent->visits : 1);
+
+	int best = UNEXPANDED;
+	double bestScore = -1.0;
+	int numUnvisited = 0;
+	for (int i = 0; i < parent->numChildren; i++) {
+		int c = parent->firstChild + i;
+		MctsNode *child = &hm->nodes[c];
+		if (!placeSetContains(legal, child->move)) continue;
+		if (child->visits == 0) {
+			// Reservoir sampling over the unvisited children
+			numUnvisited++;
+			if (randomBelow(&hm->rng, numUnvisited) == 0) best = c;
+			continue;
+		}
+		if (numUnvisited > 0) continue;
+
+		double score = child->totalValue / child->visits
+		             + EXPLORATION * sqrt(logVisits / child->visits);
+		if (score > bestScore) {
+			bestScore = score;
+			best = c;
+		}
+	}
+	return best;
+}
@@ -0,0 +1,70 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// HunterMcts.h: information set Monte Carlo tree search for the hunters
+//
+// The hunters can't see most of Dracula's moves, so there's no single
+// game to search. Instead, each iteration picks one history for Dracula
+// that fits what the hunters have seen (HvSampleDraculaTrail), fills it
+// into a copy of the game (DvDeterminise), and walks the tree in that
+// world. The tree only branches on the hunters' moves - the current
+// hunter's, then each of the others in turn - which the hunters always
+// know, so every sampled world shares the same tree and statistics.
+// Dracula's moves, and everything after the tree, are played by the
+// rollout policies in Rollout.h.
+//
+// The copies of the game are made with DvCloneFrom into memory that's
+// kept for the whole search, so iterations don't allocate.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "HunterView.h"
+#include "Places.h"
+#include "Rollout.h"
+
+#ifndef FOD__HUNTER_MCTS_H_
+#define FOD__HUNTER_MCTS_H_
+
+typedef struct hunterMcts *HunterMcts;
+
+/**
+ * Creates a search. The seed drives the sampling and the rollouts, so a
+ * fixed seed and iteration count give the same result every time.
+ */
+HunterMcts HmNew(unsigned int seed);
+
+/** Frees all memory allocated for the given search. */
+void HmFree(HunterMcts hm);
+
+/**
+ * Searches for the current hunter's move, from a fresh tree, until
+ * maxIterations iterations have been done (no limit if it's 0) or the
+ * decision deadline passes (see Decision.h). The hunters and Dracula
+ * must all have made their first moves. Returns the number of
+ * iterations done.
+ */
+int HmSearch(HunterMcts hm, HunterView hv, int maxIterations);
+
+/**
+ * Returns the move the search tried most often, or NOWHERE if it hasn't
+ * searched yet.
+ */
+PlaceId HmBestMove(HunterMcts hm);
+
+/**
+ * Writes the statistics for each of the current hunter's moves, and
+ * returns how many there were. `stats` needs room for NUM_REAL_PLACES
+ * moves.
+ */
+int HmGetRootStats(HunterMcts hm, MctsMoveStats stats[]);
+
+/**
+ * Searches from the given view on numThreads threads at once, each with
+ * its own copy of the view and its own seed (see Parallel.h), and writes
+ * their root statistics, merged, into `stats`. With one thread this is
+ * the same as HmSearch on HmNew(seed). Returns the number of moves in
+ * `stats`.
+ */
+int HmSearchParallel(HunterView hv, unsigned int seed, int numThreads,
+                     int maxIterations, MctsMoveStats stats[]);
+
+#endif // !defined(FOD__HUNTER_MCTS_H_)
@@ -13,6 +13,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "Game.h"
 #include "GameView.h"
@@ -20,20 +21,62 @@
 #include "Map.h"
 #include "Places.h"
 // add your own #includes here
-#include "Queue.h"
+#include "Arena.h"
+#include "PlaceSet.h"
 #include "utils.h"
 
+// Dracula's location distribution is stored as PROB_VECTORS short
+// vectors of floats (the last one padded with zeros), so the 71-wide
+// arithmetic compiles to SIMD instructions
+#define PROB_LANES 4
+#define PROB_VECTORS ((NUM_REAL_PLACES + PROB_LANES - 1) / PROB_LANES)
+typedef float ProbVector __attribute__((vector_size(PROB_LANES * sizeof(float))));
+
+// How many times HvSampleDraculaTrail tries for a history that fits
+// everything the hunters have seen
+#define SAMPLE_ATTEMPTS 8
+
+// DRACULA_MOVES[p] is the distribution of where Dracula goes next from
+// p: uniform over his road/boat moves and staying put
+static ProbVector DRACULA_MOVES[NUM_REAL_PLACES][PROB_VECTORS];
+
 struct hunterView {
 	GameView gv;
 	Map map;
+	
+	// Where Dracula could be, as far as the hunters can tell.
+	// draculaBelief[i] is the set of places he could have been in after
+	// his move i moves ago (0 = now), and draculaTrail[i] is that move
+	// as the hunters saw it (e.g. CITY_UNKNOWN, HIDE).
+	PlaceSet draculaBelief[TRAIL_SIZE];
+	PlaceId  draculaTrail[TRAIL_SIZE];
+	bool     draculaTrap[TRAIL_SIZE];    // whether the move left a trap
+	bool     draculaVampire[TRAIL_SIZE]; // ... or the immature vampire
+	int      numDraculaMoves;
+	
+	// How likely each place is, within draculaBelief[0]
+	ProbVector draculaProb[PROB_VECTORS];
 };
 
-static PlaceId *hunterBfs(HunterView hv, Player hunter, PlaceId src,
-                          Round r);
 static Round playerNextRound(HunterView hv, Player player);
+static int hunterRailPhase(HunterView hv, Player hunter);
+static void updateBeliefDracula(HunterView hv, const char *play);
+static void updateBeliefHunter(HunterView hv, const char *play);
+static void pinEncounter(HunterView hv, PlaceId location,
+                         const bool placed[TRAIL_SIZE]);
+static void pinTrail(HunterView hv, int movesAgo, PlaceId location);
+static PlaceSet draculaMovesFrom(HunterView hv, PlaceSet from);
+static PlaceSet draculaNeighbours(HunterView hv, PlaceSet from);
+static PlaceSet knownTrailPlaces(HunterView hv);
+static void initDraculaMoves(void) __attribute__((constructor));
+static void propagateProb(HunterView hv);
+static void restrictProb(HunterView hv, PlaceSet possible);
+static float probAt(ProbVector prob[PROB_VECTORS], PlaceId p);
+static bool samplePreviousLocation(HunterView hv, PlaceId locations[],
+                                   int i, Random *rng);
 PlaceId *HvGetMoveHistory(HunterView hv, Player player, int *numReturnedMoves, bool *canFree);
 
-bool isDoubleBack(PlaceId location);
+static bool isDoubleBack(PlaceId location);
 PlaceId traceHideByIndex(PlaceId *pastMoves, int i);
 PlaceId traceDoubleBackByIndex(PlaceId *pastMoves, int i);
 ////////////////////////////////////////////////////////////////////////
@@ -47,8 +90,23 @@ HunterView HvNew(char *pastPlays, Message messages[])
 		exit(EXIT_FAILURE);
 	}
 	
-	hv->gv = GvNew(pastPlays, messages);
+	hv->gv = GvNew("", messages);
 	hv->map = MapNew();
+	hv->numDraculaMoves = 0;
+	
+	// Before his first move, Dracula could start anywhere
+	memset(hv->draculaProb, 0, sizeof(hv->draculaProb));
+	PlaceSet anywhere = placeSetUnion(MapGetPlacesOfType(hv->map, LAND),
+	                                  MapGetPlacesOfType(hv->map, SEA));
+	placeSetRemove(&anywhere, ST_JOSEPH_AND_ST_MARY);
+	restrictProb(hv, anywhere);
+	
+	// Build up the view one play at a time, so that the belief about
+	// Dracula's location sees every play in order
+	size_t length = strlen(pastPlays);
+	for (size_t i = 0; i < length; i += 8) {
+		HvApplyPlay(hv, &pastPlays[i]);
+	}
 	return hv;
 }
 
@@ -59,6 +117,30 @@ void HvFree(HunterView hv)
 	free(hv);
 }
 
+HunterView HvClone(HunterView hv)
+{
+	HunterView copy = malloc(sizeof(*copy));
+	if (copy == NULL) {
+		fprintf(stderr, "Couldn't allocate HunterView!\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	*copy = *hv;
+	copy->gv = GvNew("", NULL);
+	GvCloneInto(copy->gv, hv->gv);
+	return copy;
+}
+
+void HvApplyPlay(HunterView hv, const char play[8])
+{
+	GvApplyPlay(hv->gv, play);
+	if (play[0] == 'D') {
+		updateBeliefDracula(hv, play);
+	} else {
+		updateBeliefHunter(hv, play);
+	}
+}
+
 ////////////////////////////////////////////////////////////////////////
 // Game State Information
 
@@ -136,72 +218,79 @@ PlaceId HvGetLastKnownDraculaLocation(HunterView hv, Round *round)
 PlaceId *HvGetShortestPathTo(HunterView hv, Player hunter, PlaceId dest,
                              int *pathLength)
 {
-	Round r = playerNextRound(hv, hunter);
 	PlaceId src = HvGetPlayerLocation(hv, hunter);
-	PlaceId *pred = hunterBfs(hv, hunter, src, r);
+	int phase = hunterRailPhase(hv, hunter);
+	int dist = MapGetHunterDistance(hv->map, phase, src, dest);
 	
-	// One pass to get the path length
-	int dist = 0;
+	// Walk back from dest along the precomputed shortest path tree
+	PlaceId *path = ArenaAllocResult(dist * sizeof(PlaceId));
 	PlaceId curr = dest;
-	while (curr != src) {
-		dist++;
-		curr = pred[curr];
-	}
-	
-	PlaceId *path = malloc(dist * sizeof(PlaceId));
-	// Another pass to copy the path in
-	int i = dist - 1;
-	curr = dest;
-	while (curr != src) {
+	for (int i = dist - 1; i >= 0; i--) {
 		path[i] = curr;
-		curr = pred[curr];
-		i--;
+		curr = MapGetHunterPathPred(hv->map, phase, src, curr);
 	}
 	
-	free(pred);
 	*pathLength = dist;
 	return path;
 }
 
-/**
- * Performs a BFS for the given hunter starting at `src`, assuming the
- * round is `r`. Returns a predecessor array.
- */
-PlaceId *hunterBfs(HunterView hv, Player hunter, PlaceId src, Round r) {
-	PlaceId *pred = malloc(NUM_REAL_PLACES * sizeof(PlaceId));
-	placesFill(pred, NUM_REAL_PLACES, -1);
-	pred[src] = src;
-	
-	Queue q1 = QueueNew(); // current round locations
-	Queue q2 = QueueNew(); // next round locations
-	
-	QueueEnqueue(q1, src);
-	while (!(QueueIsEmpty(q1) && QueueIsEmpty(q2))) {
-		PlaceId curr = QueueDequeue(q1);
-		int numReachable = 0;
-		PlaceId *reachable = GvGetReachable(hv->gv, hunter, r, curr,
-		                                    &numReachable);
+int HvGetDistance(HunterView hv, Player hunter, PlaceId dest)
+{
+	PlaceId src = HvGetPlayerLocation(hv, hunter);
+	if (!placeIsReal(src)) {
+		return -1;
+	}
+	return MapGetHunterDistance(hv->map, hunterRailPhase(hv, hunter),
+	                            src, dest);
+}
+
+void HvGetDistancesFrom(HunterView hv, Player hunter,
+                        int distances[NUM_REAL_PLACES])
+{
+	PlaceId src = HvGetPlayerLocation(hv, hunter);
+	int phase = hunterRailPhase(hv, hunter);
+	for (PlaceId p = 0; p < NUM_REAL_PLACES; p++) {
+		distances[p] = (placeIsReal(src)
+			? MapGetHunterDistance(hv->map, phase, src, p) : -1);
+	}
+}
+
+void HvGetPathPredecessors(HunterView hv, Player hunter,
+                           PlaceId pred[NUM_REAL_PLACES])
+{
+	PlaceId src = HvGetPlayerLocation(hv, hunter);
+	int phase = hunterRailPhase(hv, hunter);
+	for (PlaceId p = 0; p < NUM_REAL_PLACES; p++) {
+		pred[p] = (placeIsReal(src)
+			? MapGetHunterPathPred(hv->map, phase, src, p) : NOWHERE);
+	}
+}
+
+void HvGetEarliestArrivals(HunterView hv, Round arrivals[NUM_REAL_PLACES],
+                           Player nearest[NUM_REAL_PLACES])
+{
+	for (PlaceId p = 0; p < NUM_REAL_PLACES; p++) {
+		arrivals[p] = -1;
+		if (nearest != NULL) nearest[p] = -1;
+	}
+	
+	for (Player hunter = 0; hunter < PLAYER_DRACULA; hunter++) {
+		PlaceId src = HvGetPlayerLocation(hv, hunter);
+		if (!placeIsReal(src)) continue;
 		
-		for (int i = 0; i < numReachable; i++) {
-			if (pred[reachable[i]] == -1) {
-				pred[reachable[i]] = curr;
-				QueueEnqueue(q2, reachable[i]);
+		// A hunter whose next move is in round r gets to a place d moves
+		// away in round r + d - 1 (so d = 0 means they're already there)
+		Round firstRound = playerNextRound(hv, hunter) - 1;
+		int phase = hunterRailPhase(hv, hunter);
+		for (PlaceId p = 0; p < NUM_REAL_PLACES; p++) {
+			Round arrival = firstRound
+				+ MapGetHunterDistance(hv->map, phase, src, p);
+			if (arrivals[p] == -1 || arrival < arrivals[p]) {
+				arrivals[p] = arrival;
+				if (nearest != NULL) nearest[p] = hunter;
 			}
 		}
-		free(reachable);
-		
-		// When we've exhausted the current round's locations, advance
-		// to the next round and swap the queues (so the next round's
-		// locations becomes the current round's locations)
-		if (QueueIsEmpty(q1)) {
-			Queue tmp = q1; q1 = q2; q2 = tmp; // swap queues
-			r++;
-		}
 	}
-	
-	QueueDrop(q1);
-	QueueDrop(q2);
-	return pred;
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -255,6 +344,416 @@ static Round playerNextRound(HunterView hv, Player player) {
 	return HvGetRound(hv) + (player < HvGetPlayer(hv) ? 1 : 0);
 }
 
+/**
+ * Gets how many rail hops the hunter can make on their next move,
+ * which selects the shortest path table to use
+ */
+static int hunterRailPhase(HunterView hv, Player hunter) {
+	return (hunter + playerNextRound(hv, hunter)) % MAP_NUM_RAIL_PHASES;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Tracking Dracula
+
+PlaceSet HvGetDraculaPossibleLocations(HunterView hv)
+{
+	if (hv->numDraculaMoves == 0) {
+		return PLACE_SET_EMPTY;
+	}
+	return hv->draculaBelief[0];
+}
+
+/**
+ * Works out where Dracula could be after the given move, from where he
+ * could have been before it
+ */
+static void updateBeliefDracula(HunterView hv, const char *play) {
+	PlaceId move = placeAbbrevToId((char[3]){ play[1], play[2], '\0' });
+	PlaceSet land = MapGetPlacesOfType(hv->map, LAND);
+	PlaceSet belief;
+	
+	if (placeIsReal(move)) {
+		belief = placeSetOf(move);
+	} else if (move == TELEPORT) {
+		belief = placeSetOf(CASTLE_DRACULA);
+	} else if (move == HIDE) {
+		belief = placeSetIntersect(hv->draculaBelief[0], land);
+	} else if (move >= DOUBLE_BACK_1 && move <= DOUBLE_BACK_5) {
+		int movesAgo = move - DOUBLE_BACK_1;
+		belief = draculaMovesFrom(hv, hv->draculaBelief[0]);
+		if (movesAgo < hv->numDraculaMoves) {
+			belief = placeSetIntersect(belief,
+			                           hv->draculaBelief[movesAgo]);
+		}
+	} else {
+		// CITY_UNKNOWN or SEA_UNKNOWN: a location move, so it can't be
+		// to anywhere still in his trail. Hunters are sometimes shown a
+		// HIDE as CITY_UNKNOWN, so he may also have stayed in a city.
+		PlaceSet from = hv->draculaBelief[0];
+		if (hv->numDraculaMoves == 0) {
+			from = placeSetUnion(land, MapGetPlacesOfType(hv->map, SEA));
+		}
+		belief = (move == CITY_UNKNOWN
+			? draculaMovesFrom(hv, from)
+			: draculaNeighbours(hv, from));
+		belief = placeSetMinus(belief, knownTrailPlaces(hv));
+		belief = (move == CITY_UNKNOWN
+			? placeSetIntersect(belief, land)
+			: placeSetMinus(belief, land));
+	}
+	
+	// Traps and vampires are only ever placed in cities
+	if (play[3] == 'T' || play[4] == 'V') {
+		belief = placeSetIntersect(belief, land);
+	}
+	placeSetRemove(&belief, ST_JOSEPH_AND_ST_MARY);
+	
+	for (int i = TRAIL_SIZE - 1; i > 0; i--) {
+		hv->draculaBelief[i] = hv->draculaBelief[i - 1];
+		hv->draculaTrail[i] = hv->draculaTrail[i - 1];
+		hv->draculaTrap[i] = hv->draculaTrap[i - 1];
+		hv->draculaVampire[i] = hv->draculaVampire[i - 1];
+	}
+	hv->draculaBelief[0] = belief;
+	hv->draculaTrail[0] = move;
+	hv->draculaTrap[0] = (play[3] == 'T');
+	hv->draculaVampire[0] = (play[4] == 'V');
+	hv->numDraculaMoves++;
+	
+	if (move != HIDE) {
+		propagateProb(hv);
+	}
+	restrictProb(hv, belief);
+}
+
+/**
+ * A hunter who ends their turn in a city where Dracula is always
+ * encounters him, so if they didn't, he isn't there. Traps and the
+ * vampire stay where he left them, so meeting one says where he was
+ * when he left it.
+ */
+static void updateBeliefHunter(HunterView hv, const char *play) {
+	if (hv->numDraculaMoves == 0) return;
+	
+	Player hunter = strchr("GSHM", play[0]) - "GSHM";
+	PlaceId location = placeAbbrevToId((char[3]){ play[1], play[2], '\0' });
+	
+	if (memchr(&play[3], 'T', 4) != NULL) {
+		pinEncounter(hv, location, hv->draculaTrap);
+	}
+	if (memchr(&play[3], 'V', 4) != NULL) {
+		pinEncounter(hv, location, hv->draculaVampire);
+	}
+	
+	if (memchr(&play[3], 'D', 4) != NULL) {
+		hv->draculaBelief[0] = placeSetOf(location);
+	
+	// If the hunter was sent to the hospital, they might not have got
+	// as far as the Dracula encounter
+	} else if (placeIsLand(location) &&
+	           GvGetPlayerLocation(hv->gv, hunter) == location) {
+		placeSetRemove(&hv->draculaBelief[0], location);
+	}	
+	restrictProb(hv, hv->draculaBelief[0]);
+}
+
+/**
+ * Pins the move in Dracula's trail that left the trap or vampire the
+ * hunter met at the given location. If more than one of them could have
+ * been there, it's not clear which, so nothing is learnt.
+ */
+static void pinEncounter(HunterView hv, PlaceId location,
+                         const bool placed[TRAIL_SIZE]) {
+	int n = hv->numDraculaMoves < TRAIL_SIZE
+		? hv->numDraculaMoves : TRAIL_SIZE;
+	int movesAgo = -1;
+	for (int i = 0; i < n; i++) {
+		if (placed[i] && placeSetContains(hv->draculaBelief[i], location)) {
+			if (movesAgo >= 0) return;
+			movesAgo = i;
+		}
+	}
+	if (movesAgo >= 0) pinTrail(hv, movesAgo, location);
+}
+
+/**
+ * Sets where Dracula was after the move the given number of moves ago,
+ * and narrows down where he could have been after each later move to
+ * match. Leaves the belief as it was if that leaves nowhere for him to
+ * be.
+ */
+static void pinTrail(HunterView hv, int movesAgo, PlaceId location) {
+	PlaceSet belief[TRAIL_SIZE];
+	memcpy(belief, hv->draculaBelief, sizeof(belief));
+	belief[movesAgo] = placeSetIntersect(belief[movesAgo],
+	                                     placeSetOf(location));
+	
+	for (int i = movesAgo - 1; i >= 0; i--) {
+		PlaceId move = hv->draculaTrail[i];
+		PlaceSet after = belief[i];
+		if (move == HIDE) {
+			after = belief[i + 1];
+		} else if (move >= DOUBLE_BACK_1 && move <= DOUBLE_BACK_5) {
+			int back = i + (move - DOUBLE_BACK_1) + 1;
+			if (back < TRAIL_SIZE) after = belief[back];
+		} else if (move == CITY_UNKNOWN) {
+			after = draculaMovesFrom(hv, belief[i + 1]);
+		} else if (move == SEA_UNKNOWN) {
+			after = draculaNeighbours(hv, belief[i + 1]);
+		}
+		belief[i] = placeSetIntersect(belief[i], after);
+	}
+	
+	for (int i = 0; i <= movesAgo; i++) {
+		if (placeSetIsEmpty(belief[i])) return;
+	}
+	memcpy(hv->draculaBelief, belief, sizeof(belief));
+}
+
+/**
+ * Moves Dracula's location distribution on by one move
+ */
+static void propagateProb(HunterView hv) {
+	ProbVector next[PROB_VECTORS] = {};
+	for (PlaceId p = 0; p < NUM_REAL_PLACES; p++) {
+		float weight = probAt(hv->draculaProb, p);
+		if (weight == 0.0f) continue;
+		for (int i = 0; i < PROB_VECTORS; i++) {
+			next[i] += weight * DRACULA_MOVES[p][i];
+		}
+	}
+	memcpy(hv->draculaProb, next, sizeof(next));
+}
+
+/**
+ * Zeroes the probability of every place outside the given set, and
+ * scales the rest back up to sum to 1. If nothing is left, falls back
+ * to a uniform distribution over the set.
+ */
+static void restrictProb(HunterView hv, PlaceSet possible) {
+	ProbVector mask[PROB_VECTORS] = {};
+	for (PlaceId p; (p = placeSetPop(&possible)) != NOWHERE; ) {
+		mask[p / PROB_LANES][p % PROB_LANES] = 1.0f;
+	}
+	
+	ProbVector sums = {};
+	for (int i = 0; i < PROB_VECTORS; i++) {
+		hv->draculaProb[i] *= mask[i];
+		sums += hv->draculaProb[i];
+	}
+	
+	float total = 0.0f;
+	for (int lane = 0; lane < PROB_LANES; lane++) {
+		total += sums[lane];
+	}
+	if (total <= 0.0f) {
+		memcpy(hv->draculaProb, mask, sizeof(mask));
+		for (int i = 0; i < PROB_VECTORS; i++) {
+			for (int lane = 0; lane < PROB_LANES; lane++) {
+				total += mask[i][lane];
+			}
+		}
+		if (total == 0.0f) return;
+	}
+	
+	float scale = 1.0f / total;
+	for (int i = 0; i < PROB_VECTORS; i++) {
+		hv->draculaProb[i] *= scale;
+	}
+}
+
+static float probAt(ProbVector prob[PROB_VECTORS], PlaceId p) {
+	return prob[p / PROB_LANES][p % PROB_LANES];
+}
+
+/**
+ * Fills in DRACULA_MOVES from the map, once at startup
+ */
+static void initDraculaMoves(void) {
+	Map map = MapNew();
+	for (PlaceId p = 0; p < NUM_REAL_PLACES; p++) {
+		PlaceSet next = placeSetUnion(MapGetNeighbourSet(map, p, ROAD),
+		                              MapGetNeighbourSet(map, p, BOAT));
+		placeSetAdd(&next, p);
+		placeSetRemove(&next, ST_JOSEPH_AND_ST_MARY);
+		
+		float weight = 1.0f / placeSetSize(next);
+		for (PlaceId q; (q = placeSetPop(&next)) != NOWHERE; ) {
+			DRACULA_MOVES[p][q / PROB_LANES][q % PROB_LANES] = weight;
+		}
+	}
+	MapFree(map);
+}
+
+/**
+ * Gets the places Dracula could get to with one road/boat move from
+ * any of the given places (including staying put)
+ */
+static PlaceSet draculaMovesFrom(HunterView hv, PlaceSet from) {
+	return placeSetUnion(from, draculaNeighbours(hv, from));
+}
+
+/**
+ * Gets the places Dracula can move to from any of the given places by a
+ * location move, which can't leave him where he was
+ */
+static PlaceSet draculaNeighbours(HunterView hv, PlaceSet from) {
+	PlaceSet reachable = PLACE_SET_EMPTY;
+	for (PlaceId p; (p = placeSetPop(&from)) != NOWHERE; ) {
+		reachable = placeSetUnion(reachable,
+			MapGetNeighbourSet(hv->map, p, ROAD));
+		reachable = placeSetUnion(reachable,
+			MapGetNeighbourSet(hv->map, p, BOAT));
+	}
+	return reachable;
+}
+
+/**
+ * Gets the places in Dracula's trail (the last TRAIL_SIZE - 1 moves)
+ * that we know he went to with a location move, which he can't make a
+ * location move to again
+ */
+static PlaceSet knownTrailPlaces(HunterView hv) {
+	PlaceSet places = PLACE_SET_EMPTY;
+	int n = hv->numDraculaMoves < TRAIL_SIZE - 1
+		? hv->numDraculaMoves : TRAIL_SIZE - 1;
+	for (int i = 0; i < n; i++) {
+		PlaceId move = hv->draculaTrail[i];
+		bool locationMove = placeIsReal(move) ||
+		                    move == CITY_UNKNOWN || move == SEA_UNKNOWN;
+		if (locationMove && placeSetSize(hv->draculaBelief[i]) == 1) {
+			places = placeSetUnion(places, hv->draculaBelief[i]);
+		}
+	}
+	return places;
+}
+
+float HvGetDraculaProbability(HunterView hv, PlaceId place)
+{
+	if (hv->numDraculaMoves == 0 || !placeIsReal(place)) {
+		return 0.0f;
+	}
+	return probAt(hv->draculaProb, place);
+}
+
+int HvGetLikelyDraculaLocations(HunterView hv, int k, PlaceId places[],
+                                float probs[])
+{
+	if (hv->numDraculaMoves == 0) {
+		return 0;
+	}
+	
+	// Insertion sort into the top k, highest probability first (ties go
+	// to the lower PlaceId, since those are inserted first)
+	int n = 0;
+	for (PlaceId p = 0; p < NUM_REAL_PLACES; p++) {
+		float prob = probAt(hv->draculaProb, p);
+		if (prob <= 0.0f) continue;
+		
+		int i = (n < k ? n++ : k);
+		for (; i > 0 && probs[i - 1] < prob; i--) {
+			if (i < k) {
+				places[i] = places[i - 1];
+				probs[i] = probs[i - 1];
+			}
+		}
+		if (i < k) {
+			places[i] = p;
+			probs[i] = prob;
+		}
+	}
+	return n;
+}
+
+int HvSampleDraculaTrail(HunterView hv, PlaceId locations[TRAIL_SIZE],
+                         Random *rng)
+{
+	int n = hv->numDraculaMoves < TRAIL_SIZE
+		? hv->numDraculaMoves : TRAIL_SIZE;
+	if (n == 0) return 0;
+	
+	// Where he is now, weighted by the probability distribution
+	float total = 0.0f;
+	for (PlaceSet s = hv->draculaBelief[0]; !placeSetIsEmpty(s); ) {
+		total += probAt(hv->draculaProb, placeSetPop(&s));
+	}
+	float r = total * (float) randomUnit(rng);
+	locations[0] = NOWHERE;
+	for (PlaceSet s = hv->draculaBelief[0]; !placeSetIsEmpty(s); ) {
+		PlaceId p = placeSetPop(&s);
+		locations[0] = p;
+		r -= probAt(hv->draculaProb, p);
+		if (r < 0.0f) break;
+	}
+	if (locations[0] == NOWHERE) return 0;
+	
+	// Then where he came from, one move at a time. Picking each place
+	// only by the move after it can paint a DOUBLE_BACK into a corner,
+	// so try again a few times before settling for a history that
+	// doesn't quite fit.
+	for (int attempt = 0; attempt < SAMPLE_ATTEMPTS; attempt++) {
+		bool consistent = true;
+		for (int i = 1; i < n; i++) {
+			consistent &= samplePreviousLocation(hv, locations, i, rng);
+		}
+		if (consistent) break;
+	}
+	return n;
+}
+
+GameView HvGetGameView(HunterView hv)
+{
+	return hv->gv;
+}
+
+/**
+ * Picks where Dracula was i moves ago (locations[i]), given where he was
+ * after each of his later moves. Returns false if no place fits
+ * everything the hunters know, in which case the place picked fits as
+ * much as possible.
+ */
+static bool samplePreviousLocation(HunterView hv, PlaceId locations[],
+                                   int i, Random *rng) {
+	PlaceId next = locations[i - 1];
+	PlaceId move = hv->draculaTrail[i - 1];
+	
+	// Places he could have made his next move from
+	PlaceSet from;
+	if (move == HIDE || move == DOUBLE_BACK_1) {
+		from = placeSetOf(next);
+	} else if (move == TELEPORT) {
+		from = hv->draculaBelief[i];
+	} else if (move == CITY_UNKNOWN) {
+		from = draculaMovesFrom(hv, placeSetOf(next));
+	} else {
+		from = draculaNeighbours(hv, placeSetOf(next));
+	}
+	
+	// A later DOUBLE_BACK to this move says exactly where he was
+	for (int j = 0; j < i; j++) {
+		PlaceId db = hv->draculaTrail[j];
+		if (db >= DOUBLE_BACK_1 && db <= DOUBLE_BACK_5 &&
+		    j + (db - DOUBLE_BACK_1 + 1) == i) {
+			from = placeSetIntersect(from, placeSetOf(locations[j]));
+		}
+	}
+	
+	// Fall back on weaker constraints if the belief doesn't agree
+	PlaceSet choices = placeSetIntersect(from, hv->draculaBelief[i]);
+	bool consistent = !placeSetIsEmpty(choices);
+	if (placeSetIsEmpty(choices)) choices = from;
+	if (placeSetIsEmpty(choices)) choices = hv->draculaBelief[i];
+	if (placeSetIsEmpty(choices)) choices = placeSetOf(next);
+	
+	int k = randomBelow(rng, placeSetSize(choices));
+	PlaceId p = placeSetPop(&choices);
+	for (; k > 0; k--) {
+		p = placeSetPop(&choices);
+	}
+	locations[i] = p;
+	return consistent;
+}
+
 ////////////////////////////////////////////////////////////////////////
 // Your own interface functions
 
@@ -282,7 +781,7 @@ PlaceId traceDoubleBackByIndex(PlaceId *pastMoves, int i)
 }
 
 // Check if the location is Double back
-bool isDoubleBack(PlaceId location) 
+static bool isDoubleBack(PlaceId location)
 {
 	return (location >= DOUBLE_BACK_1 && location <= DOUBLE_BACK_5);
 }
@@ -19,8 +19,11 @@
 #include <stdbool.h>
 
 #include "Game.h"
+#include "GameView.h"
 #include "Places.h"
 // add your own #includes here
+#include "PlaceSet.h"
+#include "Random.h"
 
 typedef struct hunterView *HunterView;
 
@@ -52,6 +55,18 @@ HunterView HvNew(char *pastPlays, Message messages[]);
  */
 void HvFree(HunterView hv);
 
+/**
+ * Advances  the  view  by a single play (see GvApplyPlay). This is much
+ * cheaper than creating a new view from the extended pastPlays string.
+ */
+void HvApplyPlay(HunterView hv, const char play[8]);
+
+/**
+ * Makes  a copy of `hv` that can be changed without affecting it. Free
+ * the copy with HvFree.
+ */
+HunterView HvClone(HunterView hv);
+
 ////////////////////////////////////////////////////////////////////////
 // Game State Information
 
@@ -153,6 +168,109 @@ PlaceId HvGetLastKnownDraculaLocation(HunterView hv, Round *round);
 PlaceId *HvGetShortestPathTo(HunterView hv, Player hunter, PlaceId dest,
                              int *pathLength);
 
+/**
+ * Gets  the  number  of  moves  the  given hunter needs to get from their
+ * current  location  to  the given location, i.e. the length of the path
+ * HvGetShortestPathTo would return. Shortest paths are precomputed  for
+ * every pair of places, so this is a table lookup.
+ *
+ * Returns -1 if the hunter hasn't made a move yet.
+ */
+int HvGetDistance(HunterView hv, Player hunter, PlaceId dest);
+
+/**
+ * Fills  `distances`  with  the  number of moves the given hunter needs
+ * to  get  from  their current location to every place, so any number of
+ * destinations can be compared for the cost of one lookup each.
+ *
+ * If the hunter hasn't made a move yet, every distance is -1.
+ */
+void HvGetDistancesFrom(HunterView hv, Player hunter,
+                        int distances[NUM_REAL_PLACES]);
+
+/**
+ * Fills  `pred`  with  the  shortest path tree rooted at the given hunter's
+ * current  location:  pred[p]  is  the place before p on the path that
+ * HvGetShortestPathTo(hv, hunter, p, ...) would return, and the hunter's
+ * own location is its own predecessor.
+ *
+ * If the hunter hasn't made a move yet, every entry is NOWHERE.
+ */
+void HvGetPathPredecessors(HunterView hv, Player hunter,
+                           PlaceId pred[NUM_REAL_PLACES]);
+
+/**
+ * For  every  place,  gets the earliest round in which any hunter could
+ * be  there,  taking  each  hunter's  turn  order  and rail range into
+ * account. A hunter already at a place counts as arriving in the round
+ * of  their  latest move. If `nearest` is not NULL, it is filled with the
+ * hunter who gets there first (the lowest-numbered one, on a tie).
+ *
+ * If no hunter has made a move yet, every arrival round is -1.
+ */
+void HvGetEarliestArrivals(HunterView hv, Round arrivals[NUM_REAL_PLACES],
+                           Player nearest[NUM_REAL_PLACES]);
+
+////////////////////////////////////////////////////////////////////////
+// Tracking Dracula
+
+/**
+ * Gets  the  set  of  places  Dracula  could  be in right now, given
+ * everything  the  hunters  have seen. The set is kept up to date after
+ * each  play:  Dracula's  possible  places are expanded by his road and
+ * boat  moves,  narrowed  down  by  the kind of move he made (C?, S?,
+ * HIDE,  DOUBLE_BACK  or  a revealed location) and by his trail, and
+ * places  where  a  hunter  ended  their  turn without encountering him
+ * are ruled out.
+ *
+ * Returns the empty set if Dracula hasn't made a move yet.
+ */
+PlaceSet HvGetDraculaPossibleLocations(HunterView hv);
+
+/**
+ * Gets  the  probability  that  Dracula  is  at the given place right now.
+ *
+ * Alongside  the  set  of possible places, HunterView keeps a probability
+ * distribution  over  them.  Each  time  Dracula moves, it is pushed
+ * through  a  simple  model  of  his  movement  (he  is  equally likely to
+ * take  any  of  his road/boat moves or to stay put), then every place
+ * outside  the  possible set is zeroed and the rest is renormalised.
+ * Hunter visits zero the places they rule out in the same way.
+ *
+ * Returns 0 if Dracula hasn't made a move yet.
+ */
+float HvGetDraculaProbability(HunterView hv, PlaceId place);
+
+/**
+ * Gets  the  (at  most)  k  places  where  Dracula  is most likely to be,
+ * most  likely  first, storing them in `places` and their probabilities
+ * in  `probs`  (both  need room for k entries). Returns the number of
+ * places stored. Places with zero probability are never returned.
+ */
+int HvGetLikelyDraculaLocations(HunterView hv, int k, PlaceId places[],
+                                float probs[]);
+
+/**
+ * Picks  one  possible  history  for  Dracula's  recent  moves: where he
+ * was  after  each  of  his  last  moves  (up to TRAIL_SIZE), from his
+ * latest  move  back,  stored  in  `locations`.  His  current location
+ * is drawn from the probability distribution, and each earlier one from
+ * the  possible  places  he  could  have  reached  it from, so that the
+ * history agrees with his HIDE and DOUBLE_BACK moves and with what the
+ * hunters have seen. Returns how many locations were stored (0 if he
+ * hasn't moved yet).
+ *
+ * The random numbers come from `rng`. The result can be given to
+ * GvDeterminise to get a full view of the game to search ahead in.
+ */
+int HvSampleDraculaTrail(HunterView hv, PlaceId locations[TRAIL_SIZE],
+                         Random *rng);
+
+/**
+ * Returns the game view underneath `hv`. It belongs to `hv`.
+ */
+GameView HvGetGameView(HunterView hv);
+
 ////////////////////////////////////////////////////////////////////////
 // Making a Move
 
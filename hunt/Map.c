@@ -16,57 +16,32 @@
 #include <stdlib.h>
 
 #include "Map.h"
+#include "MapData.h"
+#include "PlaceSet.h"
 #include "Places.h"
 
+// The graph itself lives in the read-only tables in MapData.c, which
+// are generated from CONNECTIONS at build time (see mkMapData.c). The
+// map struct is just a handle, and there is only ever one of them.
 struct map {
 	int nV; // number of vertices
-	int nE; // number of edges
-	ConnList connections[NUM_REAL_PLACES];
 };
 
-static void addConnections(Map m);
-static void addConnection(Map m, PlaceId v, PlaceId w, TransportType type);
-static inline bool isSentinelEdge(Connection c);
-
-static ConnList connListInsert(ConnList l, PlaceId v, TransportType type);
-static bool connListContains(ConnList l, PlaceId v, TransportType type);
+static struct map europe = { NUM_REAL_PLACES };
 
 ////////////////////////////////////////////////////////////////////////
 
-/** Creates a new map. */
+/** Gets the map. */
 // #vertices always same as NUM_REAL_PLACES
 Map MapNew(void)
 {
-	Map m = malloc(sizeof(*m));
-	if (m == NULL) {
-		fprintf(stderr, "Couldn't allocate Map!\n");
-		exit(EXIT_FAILURE);
-	}
-
-	m->nV = NUM_REAL_PLACES;
-	m->nE = 0;
-	for (int i = 0; i < NUM_REAL_PLACES; i++) {
-		m->connections[i] = NULL;
-	}
-
-	addConnections(m);
-	return m;
+	return &europe;
 }
 
-/** Frees all memory allocated for the given map. */
+/** Releases the given map. */
 void MapFree(Map m)
 {
-	assert (m != NULL);
-
-	for (int i = 0; i < m->nV; i++) {
-		ConnList curr = m->connections[i];
-		while (curr != NULL) {
-			ConnList next = curr->next;
-			free(curr);
-			curr = next;
-		}
-	}
-	free(m);
+	assert(m != NULL);
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -76,9 +51,9 @@ void MapShow(Map m)
 {
 	assert(m != NULL);
 
-	printf("V = %d, E = %d\n", m->nV, m->nE);
+	printf("V = %d, E = %d\n", m->nV, MAP_NUM_CONNECTIONS);
 	for (int i = 0; i < m->nV; i++) {
-		for (ConnList curr = m->connections[i]; curr != NULL; curr = curr->next) {
+		for (ConnList curr = MapGetConnections(m, i); curr != NULL; curr = curr->next) {
 			printf("%s connects to %s by %s\n",
 			       placeIdToName((PlaceId) i),
 			       placeIdToName(curr->p),
@@ -104,11 +79,9 @@ int MapNumConnections(Map m, TransportType type)
 	assert(transportTypeIsValid(type) || type == ANY);
 
 	int nE = 0;
-	for (int i = 0; i < m->nV; i++) {
-		for (ConnList curr = m->connections[i]; curr != NULL; curr = curr->next) {
-			if (curr->type == type || type == ANY) {
-				nE++;
-			}
+	for (int i = 0; i < MAP_NUM_EDGES; i++) {
+		if (MAP_EDGES[i].type == type || type == ANY) {
+			nE++;
 		}
 	}
 
@@ -117,78 +90,73 @@ int MapNumConnections(Map m, TransportType type)
 
 ////////////////////////////////////////////////////////////////////////
 
-/// Add edges to Graph representing map of Europe
-static void addConnections(Map m)
+ConnList MapGetConnections(Map m, PlaceId p)
 {
 	assert(m != NULL);
-
-	for (int i = 0; !isSentinelEdge(CONNECTIONS[i]); i++) {
-		addConnection(m, CONNECTIONS[i].v, CONNECTIONS[i].w, CONNECTIONS[i].t);
+	assert(placeIsReal(p));
+	
+	if (MAP_EDGE_OFFSETS[p] == MAP_EDGE_OFFSETS[p + 1]) {
+		return NULL;
 	}
+	return &MAP_CONN_NODES[MAP_EDGE_OFFSETS[p]];
 }
 
-/// Add a new edge to the Map/Graph
-static void addConnection(Map m, PlaceId start, PlaceId end, TransportType type)
+const MapEdge *MapGetEdges(Map m, PlaceId p, int *numEdges)
 {
 	assert(m != NULL);
-	assert(start != end);
-	assert(placeIsReal(start));
-	assert(placeIsReal(end));
-	assert(transportTypeIsValid(type));
-
-	// don't add edges twice
-	if (connListContains(m->connections[start], end, type)) return;
-
-	m->connections[start] = connListInsert(m->connections[start], end, type);
-	m->connections[end]   = connListInsert(m->connections[end], start, type);
-	m->nE++;
+	assert(placeIsReal(p));
+	
+	*numEdges = MAP_EDGE_OFFSETS[p + 1] - MAP_EDGE_OFFSETS[p];
+	return &MAP_EDGES[MAP_EDGE_OFFSETS[p]];
 }
 
-/// Is this the magic 'sentinel' edge?
-static inline bool isSentinelEdge(Connection c)
+PlaceSet MapGetNeighbourSet(Map m, PlaceId p, TransportType type)
 {
-	return c.v == -1 && c.w == -1 && c.t == ANY;
+	assert(m != NULL);
+	assert(placeIsReal(p));
+	
+	switch (type) {
+		case ROAD: return MAP_ROAD_SETS[p];
+		case BOAT: return MAP_BOAT_SETS[p];
+		case RAIL: return placeSetMinus(MAP_RAIL_SETS[1][p], placeSetOf(p));
+		default:
+			return placeSetUnion(placeSetUnion(MAP_ROAD_SETS[p], MAP_BOAT_SETS[p]),
+			                     placeSetMinus(MAP_RAIL_SETS[1][p], placeSetOf(p)));
+	}
 }
 
-/// Insert a node into an adjacency list.
-static ConnList connListInsert(ConnList l, PlaceId p, TransportType type)
+PlaceSet MapGetPlacesOfType(Map m, PlaceType type)
 {
-	assert(placeIsReal(p));
-	assert(transportTypeIsValid(type));
-
-	ConnList new = malloc(sizeof(*new));
-	if (new == NULL) {
-		fprintf(stderr, "Couldn't allocate ConnNode");
-		exit(EXIT_FAILURE);
-	}
+	assert(m != NULL);
+	assert(type == LAND || type == SEA);
 	
-	new->p = p;
-	new->type = type;
-	new->next = l;
-	return new;
+	return type == LAND ? MAP_LAND_SET : MAP_SEA_SET;
 }
 
-/// Does this adjacency list contain a particular value?
-static bool connListContains(ConnList l, PlaceId p, TransportType type)
+PlaceSet MapGetRailSet(Map m, PlaceId p, int maxHops)
 {
+	assert(m != NULL);
 	assert(placeIsReal(p));
-	assert(transportTypeIsValid(type));
-
-	for (ConnList curr = l; curr != NULL; curr = curr->next) {
-		if (curr->p == p && curr->type == type) {
-			return true;
-		}
-	}
+	assert(maxHops >= 0 && maxHops <= MAP_MAX_RAIL_HOPS);
 	
-	return false;
+	return MAP_RAIL_SETS[maxHops][p];
 }
 
-////////////////////////////////////////////////////////////////////////
-
-ConnList MapGetConnections(Map m, PlaceId p)
+int MapGetHunterDistance(Map m, int railPhase, PlaceId src, PlaceId dest)
 {
-	assert(placeIsReal(p));
-	return m->connections[p];
+	assert(m != NULL);
+	assert(placeIsReal(src) && placeIsReal(dest));
+	assert(railPhase >= 0 && railPhase < MAP_NUM_RAIL_PHASES);
+	
+	return MAP_HUNTER_DIST[railPhase][src][dest];
 }
 
-////////////////////////////////////////////////////////////////////////
+PlaceId MapGetHunterPathPred(Map m, int railPhase, PlaceId src,
+                             PlaceId dest)
+{
+	assert(m != NULL);
+	assert(placeIsReal(src) && placeIsReal(dest));
+	assert(railPhase >= 0 && railPhase < MAP_NUM_RAIL_PHASES);
+	
+	return MAP_HUNTER_PRED[railPhase][src][dest];
+}
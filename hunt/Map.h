@@ -13,25 +13,44 @@
 #include <stdbool.h>
 #include <stdlib.h>
 
+#include "PlaceSet.h"
 #include "Places.h"
 
 #ifndef FOD__MAP_H_
 #define FOD__MAP_H_
 
-typedef struct connNode *ConnList;
+// The most rail hops anyone can make in one move
+#define MAP_MAX_RAIL_HOPS 3
+
+// A hunter's rail range cycles through (player + round) % 4 hops, so
+// the rail network behaves like one of only four graphs on any move
+#define MAP_NUM_RAIL_PHASES 4
+
+// The lists are part of the generated map, which every view shares, so
+// they can only be read
+typedef const struct connNode *ConnList;
 struct connNode {
 	PlaceId p; // ALICANTE, etc.
 	TransportType type; // ROAD, RAIL, BOAT
 	ConnList next; // link to next node
 };
 
+/** A connection in the compact (index-based) form of the map. */
+typedef struct mapEdge {
+	unsigned char p;    // PlaceId of the destination
+	unsigned char type; // TransportType
+} MapEdge;
+
 // Map representation is hidden
 typedef struct map *Map;
 
-/** Creates a new map. */
+/**
+ * Gets the map. The map is generated at build time and shared by every
+ * caller, so this doesn't allocate anything.
+ */
 Map MapNew(void);
 
-/** Frees all memory allocated for the given map. */
+/** Releases the given map (which doesn't need to do anything). */
 void MapFree(Map m);
 
 /** Prints a map to `stdout`. */
@@ -49,4 +68,43 @@ int MapNumConnections(Map m, TransportType type);
  */
 ConnList MapGetConnections(Map m, PlaceId p);
 
+/**
+ *  Gets the connections from the given place as an array, and sets
+ *  *numEdges to its length. Cheaper to walk than MapGetConnections,
+ *  and in the same order. The array should NOT be modified or freed.
+ */
+const MapEdge *MapGetEdges(Map m, PlaceId p, int *numEdges);
+
+/**
+ *  Gets the set of places one connection of the given type away from
+ *  the given place (not including the place itself).
+ */
+PlaceSet MapGetNeighbourSet(Map m, PlaceId p, TransportType type);
+
+/**
+ *  Gets the set of all places of the given type (LAND or SEA).
+ */
+PlaceSet MapGetPlacesOfType(Map m, PlaceType type);
+
+/**
+ *  Gets the set of places within maxHops rail hops of the given place,
+ *  including the place itself. maxHops must be 0..MAP_MAX_RAIL_HOPS.
+ */
+PlaceSet MapGetRailSet(Map m, PlaceId p, int maxHops);
+
+/**
+ *  Gets the number of moves a hunter needs to get from src to dest, if
+ *  they can go `railPhase` rail hops on their first move (that is, it's
+ *  (player + round) % 4 for that move). The answer is precomputed.
+ */
+int MapGetHunterDistance(Map m, int railPhase, PlaceId src, PlaceId dest);
+
+/**
+ *  Gets the place before dest on a shortest hunter path from src (see
+ *  MapGetHunterDistance), or src if dest == src. Following these back
+ *  from dest gives the whole path.
+ */
+PlaceId MapGetHunterPathPred(Map m, int railPhase, PlaceId src,
+                             PlaceId dest);
+
 #endif // !defined(FOD__MAP_H_)
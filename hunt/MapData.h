@@ -0,0 +1,50 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// MapData.h: the tables generated into MapData.c by mkMapData
+//
+// Only Map.c should need these; everything else goes through Map.h.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "Map.h"
+#include "PlaceSet.h"
+#include "Places.h"
+
+#ifndef FOD__MAP_DATA_H_
+#define FOD__MAP_DATA_H_
+
+/** Number of distinct (undirected) connections. */
+extern const int MAP_NUM_CONNECTIONS;
+
+/** Number of directed edges, i.e. the length of MAP_EDGES. */
+extern const int MAP_NUM_EDGES;
+
+/** The edges out of place p are MAP_EDGES[MAP_EDGE_OFFSETS[p]] up to
+ *  (but not including) MAP_EDGES[MAP_EDGE_OFFSETS[p + 1]]. */
+extern const int MAP_EDGE_OFFSETS[NUM_REAL_PLACES + 1];
+extern const MapEdge MAP_EDGES[];
+
+/** The same edges as MAP_EDGES, as ready-made linked lists. */
+extern const struct connNode MAP_CONN_NODES[];
+
+/** Places one road/boat connection away from each place. */
+extern const PlaceSet MAP_ROAD_SETS[NUM_REAL_PLACES];
+extern const PlaceSet MAP_BOAT_SETS[NUM_REAL_PLACES];
+
+/** All cities (land places) and all seas. */
+extern const PlaceSet MAP_LAND_SET;
+extern const PlaceSet MAP_SEA_SET;
+
+/** MAP_RAIL_SETS[h][p] is the set of places within h rail hops of p,
+ *  including p itself. */
+extern const PlaceSet MAP_RAIL_SETS[MAP_MAX_RAIL_HOPS + 1][NUM_REAL_PLACES];
+
+/** Shortest hunter paths: MAP_HUNTER_DIST[phase][src][dest] is the number
+ *  of moves needed, and MAP_HUNTER_PRED[phase][src][dest] the place before
+ *  dest on the path. See MapGetHunterDistance. */
+extern const unsigned char
+	MAP_HUNTER_DIST[MAP_NUM_RAIL_PHASES][NUM_REAL_PLACES][NUM_REAL_PLACES];
+extern const unsigned char
+	MAP_HUNTER_PRED[MAP_NUM_RAIL_PHASES][NUM_REAL_PLACES][NUM_REAL_PLACES];
+
+#endif // !defined(FOD__MAP_DATA_H_)
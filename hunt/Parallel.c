@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// Parallel.c: root-parallel search on several threads
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "Parallel.h"
+#include "Places.h"
+#include "Rollout.h"
+
+// Spreads the threads' seeds out (the golden ratio, as a 32-bit number)
+#define SEED_STEP 0x9E3779B9u
+
+typedef struct worker {
+	ParallelSearchFn search;
+	void            *state;
+	MctsMoveStats    stats[NUM_REAL_PLACES];
+	int              numStats;
+	bool             onThread; // whether it got a thread of its own
+} Worker;
+
+static int numThreads = 1;
+
+static void initParallel(void) __attribute__((constructor));
+static int defaultNumThreads(void);
+static void *runWorker(void *arg);
+static int mergeStats(MctsMoveStats merged[], int numMerged,
+                      MctsMoveStats stats[], int numStats);
+
+/**
+ * Reads the number of threads when the program starts
+ */
+static void initParallel(void) {
+	parallelSetThreads(0);
+}
+
+static int defaultNumThreads(void) {
+	const char *value = getenv("FOD_THREADS");
+	if (value != NULL && value[0] != '\0') {
+		char *end;
+		long n = strtol(value, &end, 10);
+		if (*end == '\0' && n > 0) return (int) n;
+	}
+
+	long cores = sysconf(_SC_NPROCESSORS_ONLN);
+	return (cores > 0) ? (int) cores : 1;
+}
+
+////////////////////////////////////////////////////////////////////////
+
+int parallelNumThreads(void)
+{
+	return numThreads;
+}
+
+void parallelSetThreads(int n)
+{
+	if (n == 0) n = defaultNumThreads();
+	if (n < 1) n = 1;
+	if (n > MAX_THREADS) n = MAX_THREADS;
+	numThreads = n;
+}
+
+int parallelSearch(ParallelSearchFn search, void *states[], int n,
+                   MctsMoveStats merged[])
+{
+	Worker *workers = malloc(n * sizeof(Worker));
+	pthread_t *threads = malloc(n * sizeof(pthread_t));
+	if (workers == NULL || threads == NULL) {
+		fprintf(stderr, "Couldn't allocate search threads\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for (int i = 0; i < n; i++) {
+		workers[i] = (Worker) { .search = search, .state = states[i] };
+	}
+
+	// Thread 0's share runs here; if a thread can't be started, its
+	// share runs here too, after the others have started
+	for (int i = 1; i < n; i++) {
+		workers[i].onThread =
+			pthread_create(&threads[i], NULL, runWorker, &workers[i]) == 0;
+	}
+	runWorker(&workers[0]);
+	for (int i = 1; i < n; i++) {
+		if (workers[i].onThread) {
+			pthread_join(threads[i], NULL);
+		} else {
+			runWorker(&workers[i]);
+		}
+	}
+
+	int numMerged = 0;
+	for (int i = 0; i < n; i++) {
+		numMerged = mergeStats(merged, numMerged,
+		                       workers[i].stats, workers[i].numStats);
+	}
+
+	free(threads);
+	free(workers);
+	return numMerged;
+}
+
+PlaceId parallelBestMove(MctsMoveStats stats[], int numStats)
+{
+	PlaceId best = NOWHERE;
+	int bestVisits = -1;
+	for (int i = 0; i < numStats; i++) {
+		if (stats[i].visits > bestVisits) {
+			bestVisits = stats[i].visits;
+			best = stats[i].move;
+		}
+	}
+	return best;
+}
+
+unsigned int parallelThreadSeed(unsigned int seed, int thread)
+{
+	return seed + (unsigned int) thread * SEED_STEP;
+}
+
+static void *runWorker(void *arg) {
+	Worker *worker = arg;
+	worker->numStats = worker->search(worker->state, worker->stats);
+	return NULL;
+}
+
+/**
+ * Adds one thread's statistics into the merged ones, and returns the
+ * new number of merged moves
+ */
+static int mergeStats(MctsMoveStats merged[], int numMerged,
+                      MctsMoveStats stats[], int numStats) {
+	for (int i = 0; i < numStats; i++) {
+		int j = 0;
+		while (j < numMerged && merged[j].move != stats[i].move) j++;
+		if (j == numMerged) {
+			merged[numMerged++] = (MctsMoveStats) {
+				.move = stats[i].move, .visits = 0, .value = 0.0,
+			};
+		}
+
+		int visits = merged[j].visits + stats[i].visits;
+		if (visits > 0) {
+			merged[j].value = (merged[j].value * merged[j].visits
+			                 + stats[i].value * stats[i].visits) / visits;
+		}
+		merged[j].visits = visits;
+	}
+	return numMerged;
+}
@@ -0,0 +1,64 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// Parallel.h: root-parallel search on several threads
+//
+// Each thread runs its own search from the same position, with its own
+// copy of the view and its own random seed, so the threads share
+// nothing while they run. When they've all finished, the statistics for
+// each move at the root are added together, and the move tried most
+// often overall is the one to play.
+//
+// The number of threads is read from the environment when the program
+// starts:
+//     FOD_THREADS  how many threads to search with (default: one per
+//                  core, up to MAX_THREADS)
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "Places.h"
+#include "Rollout.h"
+
+#ifndef FOD__PARALLEL_H_
+#define FOD__PARALLEL_H_
+
+#define MAX_THREADS 32
+
+/**
+ * One thread's share of a search. Should search from `state`, write the
+ * statistics for each move at its root into `stats` (which has room for
+ * NUM_REAL_PLACES moves), and return how many there were.
+ */
+typedef int (*ParallelSearchFn)(void *state, MctsMoveStats stats[]);
+
+/** The number of threads searches should use. */
+int parallelNumThreads(void);
+
+/**
+ * Overrides the number of threads (clamped to 1..MAX_THREADS). 0 goes
+ * back to the default.
+ */
+void parallelSetThreads(int numThreads);
+
+/**
+ * Runs search(states[i], ...) on numThreads threads at once, and merges
+ * their statistics by move into `merged`: visits are added up, and the
+ * values averaged over all of them. Moves are in the order they first
+ * appear, from thread 0 on. With one thread, the search runs on the
+ * calling thread. Returns the number of moves merged.
+ */
+int parallelSearch(ParallelSearchFn search, void *states[], int numThreads,
+                   MctsMoveStats merged[]);
+
+/**
+ * Returns the move with the most visits (the first, if there's a tie),
+ * or NOWHERE if there are no moves.
+ */
+PlaceId parallelBestMove(MctsMoveStats stats[], int numStats);
+
+/**
+ * Gives each thread its own seed, starting with `seed` itself for
+ * thread 0, so that one thread searches just as a single search would.
+ */
+unsigned int parallelThreadSeed(unsigned int seed, int thread);
+
+#endif // !defined(FOD__PARALLEL_H_)
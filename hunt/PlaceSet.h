@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// PlaceSet.h: a set of real places, as a 128-bit mask
+//
+// There are only NUM_REAL_PLACES (71) real places, so a set of them
+// fits in two 64-bit words. Sets are small enough to pass and return
+// by value, and all of the operations here are a few instructions.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "Places.h"
+
+#ifndef FOD__PLACE_SET_H_
+#define FOD__PLACE_SET_H_
+
+typedef struct placeSet {
+	uint64_t bits[2]; // place p is bit (p % 64) of bits[p / 64]
+} PlaceSet;
+
+/** The empty set. */
+#define PLACE_SET_EMPTY ((PlaceSet) {{ 0, 0 }})
+
+static inline PlaceSet placeSetOf(PlaceId p)
+{
+	PlaceSet s = PLACE_SET_EMPTY;
+	s.bits[p >> 6] = UINT64_C(1) << (p & 63);
+	return s;
+}
+
+static inline bool placeSetContains(PlaceSet s, PlaceId p)
+{
+	return placeIsReal(p) && ((s.bits[p >> 6] >> (p & 63)) & 1);
+}
+
+static inline void placeSetAdd(PlaceSet *s, PlaceId p)
+{
+	s->bits[p >> 6] |= UINT64_C(1) << (p & 63);
+}
+
+static inline void placeSetRemove(PlaceSet *s, PlaceId p)
+{
+	s->bits[p >> 6] &= ~(UINT64_C(1) << (p & 63));
+}
+
+static inline PlaceSet placeSetUnion(PlaceSet a, PlaceSet b)
+{
+	return (PlaceSet) {{ a.bits[0] | b.bits[0], a.bits[1] | b.bits[1] }};
+}
+
+static inline PlaceSet placeSetIntersect(PlaceSet a, PlaceSet b)
+{
+	return (PlaceSet) {{ a.bits[0] & b.bits[0], a.bits[1] & b.bits[1] }};
+}
+
+/** The places in a that are not in b. */
+static inline PlaceSet placeSetMinus(PlaceSet a, PlaceSet b)
+{
+	return (PlaceSet) {{ a.bits[0] & ~b.bits[0], a.bits[1] & ~b.bits[1] }};
+}
+
+static inline bool placeSetIsEmpty(PlaceSet s)
+{
+	return (s.bits[0] | s.bits[1]) == 0;
+}
+
+static inline bool placeSetEquals(PlaceSet a, PlaceSet b)
+{
+	return a.bits[0] == b.bits[0] && a.bits[1] == b.bits[1];
+}
+
+static inline int placeSetSize(PlaceSet s)
+{
+	return __builtin_popcountll(s.bits[0]) + __builtin_popcountll(s.bits[1]);
+}
+
+/**
+ * Removes and returns the smallest place in the set, or NOWHERE if the
+ * set is empty. Used to iterate over a set:
+ *
+ *     for (PlaceId p; (p = placeSetPop(&s)) != NOWHERE; ) { ... }
+ */
+static inline PlaceId placeSetPop(PlaceSet *s)
+{
+	for (int w = 0; w < 2; w++) {
+		if (s->bits[w] != 0) {
+			PlaceId p = w * 64 + __builtin_ctzll(s->bits[w]);
+			s->bits[w] &= s->bits[w] - 1;
+			return p;
+		}
+	}
+	return NOWHERE;
+}
+
+/**
+ * Writes the places in the set to `places` in increasing order, and
+ * returns how many there were. `places` needs room for
+ * NUM_REAL_PLACES places.
+ */
+static inline int placeSetToArray(PlaceSet s, PlaceId *places)
+{
+	int n = 0;
+	for (PlaceId p; (p = placeSetPop(&s)) != NOWHERE; ) {
+		places[n++] = p;
+	}
+	return n;
+}
+
+#endif // !defined(FOD__PLACE_SET_H_)
@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// Random.h: a small, fast random number generator
+//
+// A PCG32 generator (O'Neill, 2014): 64 bits of state, advanced by a
+// linear congruential step, with a permuted 32-bit output. It is as
+// cheap as rand_r but much better behaved, and the state belongs to
+// the caller, so each thread (or each search) keeps its own and
+// nothing is shared. The same seed always gives the same numbers, so
+// anything driven by one can be replayed exactly; where the seeds come
+// from is up to the caller (see decisionSeed and parallelThreadSeed).
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+
+#include "Places.h"
+
+#ifndef FOD__RANDOM_H_
+#define FOD__RANDOM_H_
+
+#define RANDOM_MULTIPLIER UINT64_C(6364136223846793005)
+#define RANDOM_INCREMENT  UINT64_C(1442695040888963407)
+
+typedef struct random {
+	uint64_t state;
+} Random;
+
+/** The next 32 random bits. */
+static inline uint32_t randomNext(Random *rng)
+{
+	uint64_t old = rng->state;
+	rng->state = old * RANDOM_MULTIPLIER + RANDOM_INCREMENT;
+	uint32_t bits = (uint32_t) (((old >> 18) ^ old) >> 27);
+	uint32_t rot = (uint32_t) (old >> 59);
+	return (bits >> rot) | (bits << ((-rot) & 31));
+}
+
+/** Starts the generator from `seed`. */
+static inline void randomSeed(Random *rng, uint64_t seed)
+{
+	rng->state = 0;
+	randomNext(rng);
+	rng->state += seed;
+	randomNext(rng);
+}
+
+/**
+ * A random number from 0 to bound - 1, all equally likely (Lemire's
+ * multiply-and-shift, which only divides when it has to reject a
+ * number). bound must be at least 1.
+ */
+static inline uint32_t randomBelow(Random *rng, uint32_t bound)
+{
+	uint64_t m = (uint64_t) randomNext(rng) * bound;
+	if ((uint32_t) m < bound) {
+		uint32_t threshold = -bound % bound;
+		while ((uint32_t) m < threshold) {
+			m = (uint64_t) randomNext(rng) * bound;
+		}
+	}
+	return (uint32_t) (m >> 32);
+}
+
+/** A random number in [0, 1). */
+static inline double randomUnit(Random *rng)
+{
+	return randomNext(rng) * 0x1p-32;
+}
+
+/** Puts the places in a random order (Fisher-Yates). */
+static inline void randomShuffle(Random *rng, PlaceId places[], int n)
+{
+	for (int i = n - 1; i > 0; i--) {
+		int j = (int) randomBelow(rng, (uint32_t) i + 1);
+		PlaceId tmp = places[i];
+		places[i] = places[j];
+		places[j] = tmp;
+	}
+}
+
+#endif // !defined(FOD__RANDOM_H_)
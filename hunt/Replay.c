@@ -0,0 +1,294 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// Replay.c: a compact binary file of recorded games
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Game.h"
+#include "Replay.h"
+
+#define MAGIC         "FODREPLY"
+#define MAGIC_SIZE    8
+#define VERSION       1
+
+typedef struct fileHeader {
+	char     magic[MAGIC_SIZE];
+	uint32_t version;
+	uint32_t numGames;
+} FileHeader;
+
+typedef struct gameHeader {
+	uint32_t numPlays;
+	uint32_t numDraculaPlays;
+	int32_t  score;
+	int32_t  round;
+} GameHeader;
+
+typedef struct revealRecord {
+	char     shown[2];
+	uint16_t revealedAt;
+	uint32_t unused;
+} RevealRecord;
+
+// Where each game starts in the mapped file
+typedef struct gameIndex {
+	const GameHeader   *header;
+	const char         *plays;
+	const RevealRecord *reveals;
+} GameIndex;
+
+struct replay {
+	void      *data;
+	size_t     size;
+	int        numGames;
+	GameIndex *games;
+};
+
+struct replayWriter {
+	FILE    *file;
+	uint32_t numGames;
+};
+
+static const GameIndex *getGame(Replay rp, int game);
+static void writeOrDie(const void *data, size_t size, FILE *file);
+
+////////////////////////////////////////////////////////////////////////
+// Reading
+
+Replay ReplayOpen(const char *filename)
+{
+	int fd = open(filename, O_RDONLY);
+	if (fd < 0) return NULL;
+	
+	struct stat st;
+	if (fstat(fd, &st) < 0 || (size_t) st.st_size < sizeof(FileHeader)) {
+		close(fd);
+		return NULL;
+	}
+	
+	size_t size = st.st_size;
+	void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED) return NULL;
+	
+	const FileHeader *fh = data;
+	if (memcmp(fh->magic, MAGIC, MAGIC_SIZE) != 0
+	        || fh->version != VERSION) {
+		munmap(data, size);
+		return NULL;
+	}
+	
+	// Every game takes at least a header, so a count the file has no room
+	// for can't be right
+	if (fh->numGames > (size - sizeof(FileHeader)) / sizeof(GameHeader)) {
+		munmap(data, size);
+		return NULL;
+	}
+	
+	Replay rp = malloc(sizeof(*rp));
+	GameIndex *games = malloc((fh->numGames + 1) * sizeof(GameIndex));
+	if (rp == NULL || games == NULL) {
+		fprintf(stderr, "Couldn't allocate Replay!\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	// Find where each game starts, giving up on a file that's been cut
+	// short
+	const char *end = (const char *) data + size;
+	const char *next = (const char *) data + sizeof(FileHeader);
+	for (uint32_t i = 0; i < fh->numGames; i++) {
+		const GameHeader *gh = (const GameHeader *) next;
+		if ((size_t) (end - next) < sizeof(GameHeader)
+		        || (size_t) (end - next) - sizeof(GameHeader)
+		           < ((size_t) gh->numPlays + gh->numDraculaPlays)
+		             * REPLAY_RECORD_SIZE) {
+			free(games);
+			free(rp);
+			munmap(data, size);
+			return NULL;
+		}
+	
+		games[i].header = gh;
+		games[i].plays = next + sizeof(GameHeader);
+		games[i].reveals = (const RevealRecord *)
+			(games[i].plays + gh->numPlays * REPLAY_RECORD_SIZE);
+		next = (const char *) (games[i].reveals + gh->numDraculaPlays);
+	}
+	
+	rp->data = data;
+	rp->size = size;
+	rp->numGames = fh->numGames;
+	rp->games = games;
+	return rp;
+}
+
+void ReplayClose(Replay rp)
+{
+	assert(rp != NULL);
+	munmap(rp->data, rp->size);
+	free(rp->games);
+	free(rp);
+}
+
+int ReplayNumGames(Replay rp)
+{
+	assert(rp != NULL);
+	return rp->numGames;
+}
+
+int ReplayNumPlays(Replay rp, int game)
+{
+	return getGame(rp, game)->header->numPlays;
+}
+
+int ReplayFinalScore(Replay rp, int game)
+{
+	return getGame(rp, game)->header->score;
+}
+
+Round ReplayFinalRound(Replay rp, int game)
+{
+	return getGame(rp, game)->header->round;
+}
+
+const char *ReplayGetPlay(Replay rp, int game, int play)
+{
+	const GameIndex *g = getGame(rp, game);
+	assert(play >= 0 && play < (int) g->header->numPlays);
+	return g->plays + play * REPLAY_RECORD_SIZE;
+}
+
+void ReplayGetPastPlays(Replay rp, int game, int play, char *pastPlays)
+{
+	const GameIndex *g = getGame(rp, game);
+	assert(play >= 0 && play <= (int) g->header->numPlays);
+	
+	if (play == 0) {
+		pastPlays[0] = '\0';
+		return;
+	}
+	
+	// The records are the string already, separators and all
+	int length = play * REPLAY_RECORD_SIZE - 1;
+	memcpy(pastPlays, g->plays, length);
+	pastPlays[length] = '\0';
+	
+	if (play % NUM_PLAYERS == PLAYER_DRACULA) return;
+	
+	// Hide whatever the hunters hadn't found out yet
+	for (int d = 0; d * NUM_PLAYERS + PLAYER_DRACULA < play; d++) {
+		const RevealRecord *reveal = &g->reveals[d];
+		if (reveal->revealedAt > play) {
+			char *location = pastPlays
+				+ (d * NUM_PLAYERS + PLAYER_DRACULA) * REPLAY_RECORD_SIZE + 1;
+			location[0] = reveal->shown[0];
+			location[1] = reveal->shown[1];
+		}
+	}
+}
+
+static const GameIndex *getGame(Replay rp, int game) {
+	assert(rp != NULL);
+	assert(game >= 0 && game < rp->numGames);
+	return &rp->games[game];
+}
+
+////////////////////////////////////////////////////////////////////////
+// Writing
+
+ReplayWriter ReplayWriterNew(const char *filename)
+{
+	FILE *file = fopen(filename, "wb");
+	if (file == NULL) {
+		fprintf(stderr, "Couldn't open '%s'\n", filename);
+		exit(EXIT_FAILURE);
+	}
+	
+	ReplayWriter rw = malloc(sizeof(*rw));
+	if (rw == NULL) {
+		fprintf(stderr, "Couldn't allocate ReplayWriter!\n");
+		exit(EXIT_FAILURE);
+	}
+	rw->file = file;
+	rw->numGames = 0;
+	
+	// The number of games is filled in at the end
+	FileHeader fh = { .version = VERSION, .numGames = 0 };
+	memcpy(fh.magic, MAGIC, MAGIC_SIZE);
+	writeOrDie(&fh, sizeof(fh), rw->file);
+	return rw;
+}
+
+void ReplayWriterAddGame(ReplayWriter rw, const char *pastPlays,
+                         ReplayReveal reveals[], int score, Round round)
+{
+	assert(rw != NULL);
+	
+	int length = strlen(pastPlays);
+	int numPlays = (length + 1) / REPLAY_RECORD_SIZE;
+	assert(length == 0 || numPlays * REPLAY_RECORD_SIZE - 1 == length);
+	
+	GameHeader gh = {
+		.numPlays = numPlays,
+		.numDraculaPlays = (numPlays + NUM_PLAYERS - 1 - PLAYER_DRACULA)
+		                   / NUM_PLAYERS,
+		.score = score,
+		.round = round,
+	};
+	writeOrDie(&gh, sizeof(gh), rw->file);
+	
+	for (int i = 0; i < numPlays; i++) {
+		char record[REPLAY_RECORD_SIZE];
+		memcpy(record, pastPlays + i * REPLAY_RECORD_SIZE,
+		       REPLAY_RECORD_SIZE - 1);
+		record[REPLAY_RECORD_SIZE - 1] = ' ';
+		writeOrDie(record, REPLAY_RECORD_SIZE, rw->file);
+	}
+	
+	for (uint32_t d = 0; d < gh.numDraculaPlays; d++) {
+		assert(reveals[d].revealedAt >= 0
+		       && reveals[d].revealedAt <= REPLAY_NEVER);
+		RevealRecord record = {
+			.shown = { reveals[d].shown[0], reveals[d].shown[1] },
+			.revealedAt = reveals[d].revealedAt,
+		};
+		writeOrDie(&record, sizeof(record), rw->file);
+	}
+	
+	rw->numGames++;
+}
+
+void ReplayWriterFree(ReplayWriter rw)
+{
+	assert(rw != NULL);
+	
+	size_t offset = offsetof(FileHeader, numGames);
+	if (fseek(rw->file, offset, SEEK_SET) != 0) {
+		fprintf(stderr, "Couldn't finish replay file\n");
+		exit(EXIT_FAILURE);
+	}
+	writeOrDie(&rw->numGames, sizeof(rw->numGames), rw->file);
+	if (fclose(rw->file) != 0) {
+		fprintf(stderr, "Couldn't finish replay file\n");
+		exit(EXIT_FAILURE);
+	}
+	free(rw);
+}
+
+static void writeOrDie(const void *data, size_t size, FILE *file) {
+	if (fwrite(data, size, 1, file) != 1) {
+		fprintf(stderr, "Couldn't write replay file\n");
+		exit(EXIT_FAILURE);
+	}
+}
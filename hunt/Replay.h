@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// Replay.h: a compact binary file of recorded games
+//
+// A replay file holds whole games, so that every position in them can
+// be read back without parsing the game engine's logs (see corpus.c,
+// which makes them). It is laid out as:
+//
+//     file header   "FODREPLY", version, number of games  (16 bytes)
+//     for each game:
+//         game header   number of plays, number of Dracula's plays,
+//                       final score, final round             (16 bytes)
+//         play records  each play as Dracula sees it: the 7
+//                       characters of the play and a space    (8 bytes)
+//         reveals       for each of Dracula's plays, what the
+//                       hunters were shown in place of where he went
+//                       (e.g. "C?"), and from which play on they were
+//                       shown where he really went            (8 bytes)
+//
+// All in native byte order. The play records of a game are a pastPlays
+// string already, apart from the terminator, and the file is mapped
+// into memory rather than read, so opening even a large file is cheap.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "Game.h"
+
+#ifndef FOD__REPLAY_H_
+#define FOD__REPLAY_H_
+
+#define REPLAY_RECORD_SIZE 8
+
+// A reveal that never happened
+#define REPLAY_NEVER       0xFFFF
+
+typedef struct replay *Replay;
+typedef struct replayWriter *ReplayWriter;
+
+/** What the hunters were shown for one of Dracula's plays */
+typedef struct replayReveal {
+	char shown[2];   // in place of the location, until it's revealed
+	int  revealedAt; // the first play whose player saw the real one,
+	                 // or REPLAY_NEVER
+} ReplayReveal;
+
+////////////////////////////////////////////////////////////////////////
+// Reading
+
+/**
+ * Maps the given replay file into memory. Returns NULL if it can't be
+ * opened, or isn't a replay file.
+ */
+Replay ReplayOpen(const char *filename);
+
+/** Unmaps the file, and frees everything else. */
+void ReplayClose(Replay rp);
+
+/** The number of games in the file. */
+int ReplayNumGames(Replay rp);
+
+/** The number of plays in the given game. */
+int ReplayNumPlays(Replay rp, int game);
+
+/** The score at the end of the given game. */
+int ReplayFinalScore(Replay rp, int game);
+
+/** The round the given game ended in. */
+Round ReplayFinalRound(Replay rp, int game);
+
+/**
+ * Gets the given play of the given game, as Dracula saw it: 7
+ * characters, NOT terminated.
+ */
+const char *ReplayGetPlay(Replay rp, int game, int play);
+
+/**
+ * Fills in the pastPlays string that the player making the given play
+ * of the given game was given: everything, for Dracula, and with his
+ * unrevealed locations hidden, for the hunters. `pastPlays` must have
+ * room for play * REPLAY_RECORD_SIZE + 1 characters.
+ */
+void ReplayGetPastPlays(Replay rp, int game, int play, char *pastPlays);
+
+////////////////////////////////////////////////////////////////////////
+// Writing
+
+/** Creates the given replay file, with no games in it yet. */
+ReplayWriter ReplayWriterNew(const char *filename);
+
+/**
+ * Adds a game: its plays as Dracula saw them (a pastPlays string), and
+ * a reveal for each of Dracula's plays, in order.
+ */
+void ReplayWriterAddGame(ReplayWriter rw, const char *pastPlays,
+                         ReplayReveal reveals[], int score, Round round);
+
+/** Finishes off the file, and closes it. */
+void ReplayWriterFree(ReplayWriter rw);
+
+#endif // !defined(FOD__REPLAY_H_)
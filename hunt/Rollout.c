@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// Rollout.c: fast playout policies for Monte Carlo search
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "DraculaView.h"
+#include "Game.h"
+#include "GameView.h"
+#include "Map.h"
+#include "PlaceSet.h"
+#include "Places.h"
+#include "Random.h"
+#include "Rollout.h"
+
+// Chance that a hunter heads straight for Dracula, rather than moving
+// at random. Rollouts let the hunters see Dracula, which errs on the
+// side of caution for him.
+#define HUNTER_GREEDY      0.6
+
+// Hunters rest when they have this many life points or fewer
+#define HUNTER_REST_HEALTH 3
+
+// How positions are scored: blood points count for BLOOD_WEIGHT, and
+// the drop in the game score (out of SCORE_SCALE) for the rest
+#define BLOOD_WEIGHT       0.6
+#define SCORE_SCALE        40.0
+
+bool rolloutIsOver(DraculaView dv)
+{
+	return DvGetHealth(dv, PLAYER_DRACULA) <= 0 || DvGetScore(dv) <= 0;
+}
+
+PlaceId rolloutDraculaMove(DraculaView dv, Random *rng)
+{
+	PlaceId moves[NUM_REAL_PLACES];
+	int numMoves = DvFillValidMoves(dv, moves);
+	if (numMoves == 0) {
+		return TELEPORT;
+	}
+
+	int health = DvGetHealth(dv, PLAYER_DRACULA);
+	PlaceId safe[NUM_REAL_PLACES];
+	int numSafe = 0;
+	for (int i = 0; i < numMoves; i++) {
+		PlaceId location = DvResolveMove(dv, moves[i]);
+		bool ok = !(placeIsSea(location) && health <= LIFE_LOSS_SEA);
+		for (Player p = 0; ok && p < PLAYER_DRACULA; p++) {
+			ok = DvGetPlayerLocation(dv, p) != location;
+		}
+		if (ok) safe[numSafe++] = moves[i];
+	}
+
+	return (numSafe > 0) ? safe[randomBelow(rng, numSafe)]
+	                     : moves[randomBelow(rng, numMoves)];
+}
+
+PlaceId rolloutHunterMove(DraculaView dv, Random *rng)
+{
+	GameView gv = DvGetGameView(dv);
+	Player hunter = GvGetPlayer(gv);
+	Round round = GvGetRound(gv);
+	PlaceId from = GvGetPlayerLocation(gv, hunter);
+	if (!placeIsReal(from)) {
+		return randomBelow(rng, NUM_REAL_PLACES);
+	}
+	if (GvGetHealth(gv, hunter) <= HUNTER_REST_HEALTH) {
+		return from;
+	}
+
+	PlaceSet reachable = GvGetReachableSet(gv, hunter, round, from,
+	                                       true, true, true);
+	PlaceId dracula = GvGetPlayerLocation(gv, PLAYER_DRACULA);
+	if (placeIsReal(dracula) && randomUnit(rng) < HUNTER_GREEDY) {
+		Map map = MapNew();
+		int phase = (hunter + round + 1) % MAP_NUM_RAIL_PHASES;
+		PlaceId best = from;
+		int bestDist = MapGetHunterDistance(map, phase, from, dracula);
+		for (PlaceId p; (p = placeSetPop(&reachable)) != NOWHERE; ) {
+			int dist = MapGetHunterDistance(map, phase, p, dracula);
+			if (dist < bestDist) {
+				bestDist = dist;
+				best = p;
+			}
+		}
+		return best;
+	}
+
+	int k = randomBelow(rng, placeSetSize(reachable));
+	PlaceId p = placeSetPop(&reachable);
+	for (; k > 0; k--) {
+		p = placeSetPop(&reachable);
+	}
+	return p;
+}
+
+int rolloutPlay(DraculaView dv, int maxRounds, Random *rng)
+{
+	GameView gv = DvGetGameView(dv);
+	int numMade = 0;
+	while (numMade < maxRounds * NUM_PLAYERS && !rolloutIsOver(dv)) {
+		PlaceId move = (GvGetPlayer(gv) == PLAYER_DRACULA)
+		             ? rolloutDraculaMove(dv, rng)
+		             : rolloutHunterMove(dv, rng);
+		DvMakeMove(dv, move);
+		numMade++;
+	}
+	return numMade;
+}
+
+double rolloutScore(DraculaView dv, int startScore)
+{
+	int health = DvGetHealth(dv, PLAYER_DRACULA);
+	int score = DvGetScore(dv);
+	if (health <= 0) return 0.0;
+	if (score <= 0) return 1.0;
+
+	double blood = fmin(health, GAME_START_BLOOD_POINTS)
+	             / GAME_START_BLOOD_POINTS;
+	double drop = fmin(fmax(startScore - score, 0) / SCORE_SCALE, 1.0);
+	return BLOOD_WEIGHT * blood + (1 - BLOOD_WEIGHT) * drop;
+}
@@ -0,0 +1,64 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// Rollout.h: fast playout policies for Monte Carlo search
+//
+// A rollout plays the game forward from a full view of it (Dracula's,
+// or a hunter's view with Dracula's moves filled in), with cheap moves
+// for everyone, then scores where it ended up. The random choices come
+// from the caller's generator (see Random.h). The moves are made with
+// DvMakeMove, so the caller can take them all back afterwards. Nothing
+// here allocates memory.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+
+#include "DraculaView.h"
+#include "Game.h"
+#include "Places.h"
+#include "Random.h"
+
+#ifndef FOD__ROLLOUT_H_
+#define FOD__ROLLOUT_H_
+
+/** How a search rated one of the moves at its root. */
+typedef struct mctsMoveStats {
+	PlaceId move;   // the move
+	int     visits; // how many times the search tried it
+	double  value;  // average score of those tries (0 to 1), for the
+	                // player making the move
+} MctsMoveStats;
+
+/** Whether the game is over: Dracula is dead or the score has run out. */
+bool rolloutIsOver(DraculaView dv);
+
+/**
+ * Picks one of Dracula's valid moves at random, avoiding places where
+ * there are hunters, and the sea when it would kill him. TELEPORT if he
+ * has no valid moves.
+ */
+PlaceId rolloutDraculaMove(DraculaView dv, Random *rng);
+
+/**
+ * Picks a move for the current hunter: usually the next step on a
+ * shortest path to Dracula, otherwise a random reachable place, or
+ * resting if they are low on life points.
+ */
+PlaceId rolloutHunterMove(DraculaView dv, Random *rng);
+
+/**
+ * Plays moves for whoever's turn it is until the game is over or
+ * maxRounds rounds have been played, and returns how many moves were
+ * made.
+ */
+int rolloutPlay(DraculaView dv, int maxRounds, Random *rng);
+
+/**
+ * Scores the position for Dracula: 0 if he has been caught, 1 if the
+ * game score has run out, and otherwise in between depending on his
+ * blood points and how far the score has dropped from startScore. The
+ * hunters' score is 1 minus this.
+ */
+double rolloutScore(DraculaView dv, int startScore);
+
+#endif // !defined(FOD__ROLLOUT_H_)
@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// TransTable.c: a fixed-size transposition table for game tree search
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Places.h"
+#include "TransTable.h"
+
+#define SLOTS_PER_BUCKET 2
+
+// A packed entry is laid out as
+//   bits  0-31  value
+//   bits 32-39  move (PlaceId + 2, so that NOWHERE fits)
+//   bits 40-47  depth
+//   bits 48-49  bound
+//   bit  50     occupied
+
+#define OCCUPIED ((uint64_t) 1 << 50)
+
+typedef struct slot {
+	_Atomic uint64_t check; // hash ^ data
+	_Atomic uint64_t data;
+} Slot;
+
+struct transTable {
+	Slot    *slots;
+	uint64_t mask; // number of buckets - 1
+};
+
+static uint64_t pack(TtEntry entry);
+static TtEntry  unpack(uint64_t data);
+static int      packedDepth(uint64_t data);
+
+////////////////////////////////////////////////////////////////////////
+
+TransTable TransTableNew(int log2NumEntries)
+{
+	assert(log2NumEntries >= 1 && log2NumEntries < 40);
+	
+	TransTable tt = malloc(sizeof(*tt));
+	if (tt == NULL) {
+		fprintf(stderr, "Couldn't allocate TransTable!\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	size_t numSlots = (size_t) 1 << log2NumEntries;
+	tt->slots = calloc(numSlots, sizeof(Slot));
+	if (tt->slots == NULL) {
+		fprintf(stderr, "Couldn't allocate TransTable!\n");
+		exit(EXIT_FAILURE);
+	}
+	tt->mask = numSlots / SLOTS_PER_BUCKET - 1;
+	return tt;
+}
+
+void TransTableFree(TransTable tt)
+{
+	assert(tt != NULL);
+	free(tt->slots);
+	free(tt);
+}
+
+void TransTableClear(TransTable tt)
+{
+	assert(tt != NULL);
+	size_t numSlots = (tt->mask + 1) * SLOTS_PER_BUCKET;
+	for (size_t i = 0; i < numSlots; i++) {
+		atomic_store_explicit(&tt->slots[i].data, 0, memory_order_relaxed);
+		atomic_store_explicit(&tt->slots[i].check, 0, memory_order_relaxed);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+
+bool TransTableProbe(TransTable tt, uint64_t hash, TtEntry *entry)
+{
+	Slot *bucket = &tt->slots[(hash & tt->mask) * SLOTS_PER_BUCKET];
+	for (int i = 0; i < SLOTS_PER_BUCKET; i++) {
+		uint64_t data = atomic_load_explicit(&bucket[i].data,
+		                                     memory_order_relaxed);
+		uint64_t check = atomic_load_explicit(&bucket[i].check,
+		                                      memory_order_relaxed);
+		if ((data & OCCUPIED) && (check ^ data) == hash) {
+			*entry = unpack(data);
+			return true;
+		}
+	}
+	return false;
+}
+
+void TransTableStore(TransTable tt, uint64_t hash, TtEntry entry)
+{
+	Slot *bucket = &tt->slots[(hash & tt->mask) * SLOTS_PER_BUCKET];
+	uint64_t data = pack(entry);
+	
+	// Prefer the slot already holding this position, and don't
+	// overwrite it with a shallower search
+	Slot *victim = NULL;
+	for (int i = 0; i < SLOTS_PER_BUCKET; i++) {
+		uint64_t old = atomic_load_explicit(&bucket[i].data,
+		                                    memory_order_relaxed);
+		uint64_t check = atomic_load_explicit(&bucket[i].check,
+		                                      memory_order_relaxed);
+		if ((old & OCCUPIED) && (check ^ old) == hash) {
+			if (packedDepth(old) > entry.depth) return;
+			victim = &bucket[i];
+			break;
+		}
+	}
+	
+	// Otherwise replace the deep slot if this is at least as deep, or
+	// else the always-replace slot
+	if (victim == NULL) {
+		uint64_t deep = atomic_load_explicit(&bucket[0].data,
+		                                     memory_order_relaxed);
+		victim = (packedDepth(deep) <= entry.depth ? &bucket[0] : &bucket[1]);
+	}
+	
+	atomic_store_explicit(&victim->data, data, memory_order_relaxed);
+	atomic_store_explicit(&victim->check, hash ^ data, memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////
+
+static uint64_t pack(TtEntry entry) {
+	assert(entry.depth >= 0 && entry.depth <= 255);
+	return (uint64_t) (uint32_t) entry.value
+	     | (uint64_t) (uint8_t) (entry.move - NOWHERE) << 32
+	     | (uint64_t) (uint8_t) entry.depth << 40
+	     | (uint64_t) (entry.bound & 3) << 48
+	     | OCCUPIED;
+}
+
+static TtEntry unpack(uint64_t data) {
+	return (TtEntry) {
+		.value = (int32_t) (uint32_t) data,
+		.move  = (PlaceId) ((data >> 32) & 0xFF) + NOWHERE,
+		.depth = packedDepth(data),
+		.bound = (TtBound) ((data >> 48) & 3),
+	};
+}
+
+static int packedDepth(uint64_t data) {
+	return (data >> 40) & 0xFF;
+}
@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// TransTable.h: a fixed-size transposition table for game tree search
+//
+// Entries are keyed by GvGetHash. The table is lock-free: each slot is
+// two 64-bit words (the packed entry, and the key XORed with it), so a
+// torn write from another thread simply fails the key check on probe.
+//
+// The AIs don't link this in: their Monte Carlo searches keep their own
+// statistics in their trees, and the bounds here are for a depth-limited
+// alpha-beta search.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "Places.h"
+
+#ifndef FOD__TRANS_TABLE_H_
+#define FOD__TRANS_TABLE_H_
+
+typedef enum ttBound {
+	TT_EXACT, // the value is exact
+	TT_LOWER, // the value is a lower bound (search failed high)
+	TT_UPPER, // the value is an upper bound (search failed low)
+} TtBound;
+
+typedef struct ttEntry {
+	int     value; // score of the position, from the searcher's side
+	int     depth; // remaining depth the value was searched to (0-255)
+	PlaceId move;  // best move found, or NOWHERE
+	TtBound bound;
+} TtEntry;
+
+typedef struct transTable *TransTable;
+
+/**
+ * Creates a table with 2^log2NumEntries slots. Slots are paired into
+ * buckets: one keeps the deepest entry, the other the most recent one.
+ */
+TransTable TransTableNew(int log2NumEntries);
+
+/** Frees all memory allocated for the given table. */
+void TransTableFree(TransTable tt);
+
+/** Removes every entry from the table. */
+void TransTableClear(TransTable tt);
+
+/**
+ * Looks up the given hash. Returns true and fills in *entry if it was
+ * found, otherwise returns false and leaves *entry as it is.
+ */
+bool TransTableProbe(TransTable tt, uint64_t hash, TtEntry *entry);
+
+/**
+ * Stores an entry for the given hash. An entry for the same position is
+ * replaced unless it was searched deeper; otherwise the entry replaces
+ * the shallower of the two in its bucket.
+ */
+void TransTableStore(TransTable tt, uint64_t hash, TtEntry entry);
+
+#endif // !defined(FOD__TRANS_TABLE_H_)
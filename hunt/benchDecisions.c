@@ -0,0 +1,310 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// benchDecisions.c: time whole decisions on every recorded turn
+//
+// Plays every turn in pastPlays.txt and the recorded games (see
+// benchViews.c) through the same steps player.c does (making the view,
+// deciding, freeing the view) with the AIs linked in, and reports how
+// long the decisions took: both until the heuristic had registered its
+// move (which is all there is if the search is cut short) and until the
+// decision was over, with how many went over the turn's budget and how
+// many allocations each made. Moves registered with registerBestPlay
+// directly are the heuristic's; moves from decisionPublish are the
+// search's.
+//
+// The decisions are grouped by round, and by the part of the heuristic
+// that made its move, which is told by the move's message (e.g.
+// Dracula's "--Loop--" and "--Risk--", or the hunters' "--Drac--" and
+// "Research").
+//
+// Usage: ./benchDecisions [-t msecs] [-m msecs] [-s seed] [-r rounds]
+//                         [pastPlays.txt] [file.replay]
+//     -t msecs   the time allowed per turn (default 10)
+//     -m msecs   how long before the end to stop searching (default 0)
+//     -s seed    the seed for the first decision (default 1)
+//     -r rounds  how many rounds to a group (default 10)
+//
+// As with the referee, the AIs can be swapped, e.g.
+//     make benchDecisions DRACULA_AI=draculaNew.o
+//
+// Anything the AIs print goes to stderr, so it doesn't get mixed up
+// with the results.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "Bench.h"
+#include "Decision.h"
+#include "dracula.h"
+#include "DraculaView.h"
+#include "Game.h"
+#include "hunter.h"
+#include "HunterView.h"
+#include "Parallel.h"
+
+#define DEFAULT_PAST_PLAYS  "pastPlays.txt"
+#define DEFAULT_REPLAY      "corpus.replay"
+#define DEFAULT_TURN_MSECS  10
+#define DEFAULT_SEED        1
+#define DEFAULT_GROUP_SIZE  10
+
+#define MAX_GROUPS          256
+#define MAX_GROUP_NAME      64
+
+// Grouped by round first, then by the part of the strategy
+#define ROUND_GROUP         0
+#define BRANCH_GROUP        1
+
+typedef struct group {
+	char    name[MAX_GROUP_NAME];
+	int     kind;       // ROUND_GROUP or BRANCH_GROUP
+	int     player;     // PLAYER_DRACULA, or a hunter
+	Round   round;      // the group's first round
+	double *firstMsecs; // until the heuristic's move was registered
+	double *totalMsecs; // until the decision was over
+	int     numDecisions;
+	int     maxDecisions;
+	int     numLate;
+	long    numAllocs;
+} Group;
+
+typedef struct results {
+	Group groups[MAX_GROUPS];
+	int   numGroups;
+	int   turnMsecs;
+	int   marginMsecs;
+	int   groupSize;
+} Results;
+
+// The heuristic's move in the decision being timed
+static double heuristicTime;
+static char heuristicMessage[MESSAGE_SIZE];
+
+static void decide(BenchState *state, Results *r);
+static void addDecision(Results *r, int kind, BenchState *state,
+                        const char *branch, double firstMsecs,
+                        double totalMsecs, long numAllocs);
+static Group *getGroup(Results *r, int kind, BenchState *state,
+                       const char *branch);
+static void showResults(Results *r, FILE *out);
+static FILE *takeStdout(void);
+static int compareGroups(const void *a, const void *b);
+
+int main(int argc, char *argv[])
+{
+	Results *r = calloc(1, sizeof(Results));
+	if (r == NULL) {
+		fprintf(stderr, "Couldn't allocate results\n");
+		exit(EXIT_FAILURE);
+	}
+	r->turnMsecs = DEFAULT_TURN_MSECS;
+	r->groupSize = DEFAULT_GROUP_SIZE;
+	unsigned int seed = DEFAULT_SEED;
+	
+	int opt;
+	while ((opt = getopt(argc, argv, "t:m:s:r:")) != -1) {
+		switch (opt) {
+			case 't': r->turnMsecs = atoi(optarg);              break;
+			case 'm': r->marginMsecs = atoi(optarg);            break;
+			case 's': seed = strtoul(optarg, NULL, 10);         break;
+			case 'r': r->groupSize = atoi(optarg);              break;
+			default:
+				fprintf(stderr, "usage: %s [-t msecs] [-m msecs] [-s seed] "
+				        "[-r rounds] [pastPlays.txt] [file.replay]\n", argv[0]);
+				exit(EXIT_FAILURE);
+		}
+	}
+	if (r->groupSize < 1) r->groupSize = 1;
+	const char *pastPlaysFile =
+		(optind < argc) ? argv[optind] : DEFAULT_PAST_PLAYS;
+	const char *replayFile =
+		(optind + 1 < argc) ? argv[optind + 1] : DEFAULT_REPLAY;
+	
+	int numStates = 0;
+	BenchState *states = benchLoadStates(pastPlaysFile, replayFile,
+	                                     &numStates);
+	decisionSetBudget(r->turnMsecs, r->marginMsecs);
+	decisionSetSeed(seed);
+	
+	FILE *out = takeStdout();
+	fprintf(out, "%d decisions, %d ms per turn (%d ms margin), %d threads\n\n",
+	        numStates, r->turnMsecs, r->marginMsecs, parallelNumThreads());
+	fflush(out);
+	for (int i = 0; i < numStates; i++) {
+		decide(&states[i], r);
+	}
+	showResults(r, out);
+	fclose(out);
+	
+	for (int i = 0; i < r->numGroups; i++) {
+		free(r->groups[i].firstMsecs);
+		free(r->groups[i].totalMsecs);
+	}
+	free(r);
+	benchFreeStates(states, numStates);
+	return EXIT_SUCCESS;
+}
+
+// Stands in for the one in player.c, and notes when the heuristic
+// registered its move, and why
+void registerBestPlay(char *play, Message message)
+{
+	if (decisionNumPublished() == 0) {
+		heuristicTime = benchNowNsecs();
+		strncpy(heuristicMessage, message, MESSAGE_SIZE - 1);
+		heuristicMessage[MESSAGE_SIZE - 1] = '\0';
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+
+/**
+ * Makes one decision the way player.c does, and adds its times to its
+ * round's group and its branch's group
+ */
+static void decide(BenchState *state, Results *r) {
+	heuristicTime = 0.0;
+	heuristicMessage[0] = '\0';
+	long allocsBefore = benchNumAllocs();
+	
+	decisionBegin();
+	double start = benchNowNsecs();
+	if (state->player == PLAYER_DRACULA) {
+		DraculaView dv = DvNew(state->pastPlays, NULL);
+		decideDraculaMove(dv);
+		DvFree(dv);
+	} else {
+		HunterView hv = HvNew(state->pastPlays, NULL);
+		decideHunterMove(hv);
+		HvFree(hv);
+	}
+	double end = benchNowNsecs();
+	
+	double totalMsecs = (end - start) / 1e6;
+	double firstMsecs = (heuristicTime == 0.0) ? totalMsecs
+	                  : (heuristicTime - start) / 1e6;
+	long numAllocs = benchNumAllocs() - allocsBefore;
+	const char *branch = (heuristicTime == 0.0) ? "(no move)"
+	                   : (heuristicMessage[0] == '\0') ? "(no message)"
+	                   : heuristicMessage;
+	
+	addDecision(r, ROUND_GROUP, state, branch, firstMsecs, totalMsecs,
+	            numAllocs);
+	addDecision(r, BRANCH_GROUP, state, branch, firstMsecs, totalMsecs,
+	            numAllocs);
+}
+
+static void addDecision(Results *r, int kind, BenchState *state,
+                        const char *branch, double firstMsecs,
+                        double totalMsecs, long numAllocs) {
+	Group *g = getGroup(r, kind, state, branch);
+	if (g->numDecisions == g->maxDecisions) {
+		g->maxDecisions = (g->maxDecisions == 0) ? 64 : g->maxDecisions * 2;
+		g->firstMsecs = realloc(g->firstMsecs,
+		                        g->maxDecisions * sizeof(double));
+		g->totalMsecs = realloc(g->totalMsecs,
+		                        g->maxDecisions * sizeof(double));
+		if (g->firstMsecs == NULL || g->totalMsecs == NULL) {
+			fprintf(stderr, "Couldn't allocate times\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	g->firstMsecs[g->numDecisions] = firstMsecs;
+	g->totalMsecs[g->numDecisions] = totalMsecs;
+	g->numDecisions++;
+	g->numAllocs += numAllocs;
+	if (totalMsecs > r->turnMsecs) g->numLate++;
+}
+
+/**
+ * Finds the group a decision belongs in, making it if it's the first
+ */
+static Group *getGroup(Results *r, int kind, BenchState *state,
+                       const char *branch) {
+	bool isDracula = state->player == PLAYER_DRACULA;
+	Round round = state->round / r->groupSize * r->groupSize;
+	
+	char name[MAX_GROUP_NAME];
+	if (kind == ROUND_GROUP && r->groupSize == 1) {
+		snprintf(name, MAX_GROUP_NAME, "%s round %d",
+		         isDracula ? "Dracula" : "hunters", round);
+	} else if (kind == ROUND_GROUP) {
+		snprintf(name, MAX_GROUP_NAME, "%s rounds %d-%d",
+		         isDracula ? "Dracula" : "hunters", round,
+		         round + r->groupSize - 1);
+	} else {
+		snprintf(name, MAX_GROUP_NAME, "%s %s",
+		         isDracula ? "Dracula" : "hunters", branch);
+	}
+	
+	for (int i = 0; i < r->numGroups; i++) {
+		if (strcmp(r->groups[i].name, name) == 0) return &r->groups[i];
+	}
+	if (r->numGroups == MAX_GROUPS) {
+		fprintf(stderr, "Too many groups (try a bigger -r)\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	Group *g = &r->groups[r->numGroups++];
+	strcpy(g->name, name);
+	g->kind = kind;
+	g->player = isDracula ? PLAYER_DRACULA : PLAYER_LORD_GODALMING;
+	g->round = (kind == ROUND_GROUP) ? round : 0;
+	return g;
+}
+
+////////////////////////////////////////////////////////////////////////
+
+static void showResults(Results *r, FILE *out) {
+	qsort(r->groups, r->numGroups, sizeof(Group), compareGroups);
+	
+	fprintf(out, "%-36s %6s   %-26s   %-26s %6s %8s\n", "", "",
+	       "   heuristic move (ms)", "  whole decision (ms)", "", "");
+	fprintf(out, "%-36s %6s %8s %8s %8s   %8s %8s %8s %6s %8s\n", "group",
+	       "count", "p50", "p99", "max", "p50", "p99", "max", "late",
+	       "allocs");
+	for (int i = 0; i < r->numGroups; i++) {
+		Group *g = &r->groups[i];
+		if (i > 0 && g->kind != r->groups[i - 1].kind) fprintf(out, "\n");
+		
+		int n = g->numDecisions;
+		double firstP50 = benchPercentile(g->firstMsecs, n, 50);
+		double firstP99 = benchPercentile(g->firstMsecs, n, 99);
+		double firstMax = benchPercentile(g->firstMsecs, n, 100);
+		double totalP50 = benchPercentile(g->totalMsecs, n, 50);
+		double totalP99 = benchPercentile(g->totalMsecs, n, 99);
+		double totalMax = benchPercentile(g->totalMsecs, n, 100);
+		fprintf(out, "%-36.36s %6d %8.3f %8.3f %8.3f   %8.2f %8.2f %8.2f %6d %8.0f\n",
+		       g->name, n, firstP50, firstP99, firstMax,
+		       totalP50, totalP99, totalMax, g->numLate,
+		       (double) g->numAllocs / n);
+	}
+}
+
+/**
+ * Rounds before branches, Dracula before the hunters, then in order of
+ * round or name
+ */
+static int compareGroups(const void *a, const void *b) {
+	const Group *x = a;
+	const Group *y = b;
+	if (x->kind != y->kind) return x->kind - y->kind;
+	if (x->player != y->player) return y->player - x->player;
+	if (x->round != y->round) return x->round - y->round;
+	return strcmp(x->name, y->name);
+}
+
+/**
+ * Sends anything else written to stdout to stderr, and returns a stream
+ * to the real stdout
+ */
+static FILE *takeStdout(void) {
+	FILE *out = fdopen(dup(STDOUT_FILENO), "w");
+	dup2(STDERR_FILENO, STDOUT_FILENO);
+	return out;
+}
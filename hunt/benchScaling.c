@@ -0,0 +1,408 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// benchScaling.c: time the view functions against the length of a game
+//
+// Plays one legal game of 500 rounds with simple policies, and times
+// the view functions on the state after 10, 50, 100, 200, 366 and 500
+// rounds, to show how the time and memory each call takes grows as the
+// game goes on. A game can't go past 366 rounds (the score has run out
+// by then), so the last length is the same game played on past its
+// end; it's there to make anything worse than linear stand out.
+//
+// The game is played with GENERATE_CAUTIOUS (see Generate.h), which
+// keeps everyone out of trouble, and played again (with the next seed)
+// if it ends early anyway.
+//
+// For each length, the functions run on two states: Dracula's turn
+// (his pastPlays) and Lord Godalming's turn (with Dracula's moves
+// hidden the way the referee hides them). The report has a table each
+// for the time, allocations and bytes allocated per call, and a growth
+// column: how the 500-round figure compares to the 100-round one, as a
+// power of the length (about 0 for constant, 1 for linear, 2 for
+// quadratic).
+//
+// Usage: ./benchScaling [-n] [-s seed] [-o states.txt] [-c results.csv]
+//     -n               don't time anything, just write the states
+//     -s seed          the seed for the first game (default 1)
+//     -o states.txt    also write the states, one pastPlays per line
+//                      (for view/benchScaling, or ./benchViews)
+//     -c results.csv   also write the results as
+//                      impl,function,rounds,ns_per_op,allocs_per_op,bytes_per_op
+//                      e.g. for plotting with gnuplot or a spreadsheet
+//
+// As with the other benchmarks, FOD_BENCH_MSECS sets how long each
+// function runs for at each length (see Bench.h).
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "Bench.h"
+#include "DraculaView.h"
+#include "Game.h"
+#include "GameView.h"
+#include "Generate.h"
+#include "HunterView.h"
+#include "Places.h"
+#include "Random.h"
+
+#define DEFAULT_SEED 1
+#define MAX_TRIES    100
+
+#define NUM_LENGTHS  6
+static const int lengths[NUM_LENGTHS] = { 10, 50, 100, 200, 366, 500 };
+
+// The lengths the growth column compares
+#define GROWTH_FROM  2
+#define GROWTH_TO    5
+
+#define PLAY_SIZE    8 // 7 characters and a space
+
+// Everything the functions run on, at one length
+typedef struct length {
+	int         rounds;
+	char       *draculaPlays; // Dracula's turn in the last round
+	char       *hunterPlays;  // Lord Godalming's turn after it
+	GameView    gv;
+	HunterView  hv;
+	DraculaView dv;
+} Length;
+
+typedef struct function {
+	const char *name;
+	BenchOp     op;
+} Function;
+
+static char *playGame(int numRounds, Random *rng);
+static char *hidePlays(const char *pastPlays, int numPlays);
+static void showTable(const char *title, BenchResult results[][NUM_LENGTHS],
+                      Function functions[], int numFunctions, int metric);
+static double metricOf(BenchResult *r, int metric);
+
+static void benchGvNew(void *arg, int i);
+static void benchGvGetMoveHistory(void *arg, int i);
+static void benchGvGetLocationHistory(void *arg, int i);
+static void benchGvGetLastMoves(void *arg, int i);
+static void benchGvGetTrapLocations(void *arg, int i);
+static void benchGvGetReachableByType(void *arg, int i);
+static void benchHvNew(void *arg, int i);
+static void benchHvGetLastKnownDraculaLocation(void *arg, int i);
+static void benchHvGetShortestPathTo(void *arg, int i);
+static void benchDvNew(void *arg, int i);
+static void benchDvGetValidMoves(void *arg, int i);
+static void benchDvWhereCanTheyGoByType(void *arg, int i);
+
+static Function functions[] = {
+	{ "GvNew",                         benchGvNew },
+	{ "GvGetMoveHistory",              benchGvGetMoveHistory },
+	{ "GvGetLocationHistory",          benchGvGetLocationHistory },
+	{ "GvGetLastMoves",                benchGvGetLastMoves },
+	{ "GvGetTrapLocations",            benchGvGetTrapLocations },
+	{ "GvGetReachableByType",          benchGvGetReachableByType },
+	{ "HvNew",                         benchHvNew },
+	{ "HvGetLastKnownDraculaLocation", benchHvGetLastKnownDraculaLocation },
+	{ "HvGetShortestPathTo",           benchHvGetShortestPathTo },
+	{ "DvNew",                         benchDvNew },
+	{ "DvGetValidMoves",               benchDvGetValidMoves },
+	{ "DvWhereCanTheyGoByType",        benchDvWhereCanTheyGoByType },
+};
+#define NUM_FUNCTIONS ((int) (sizeof(functions) / sizeof(functions[0])))
+
+// What the tables show
+#define NSECS  0
+#define ALLOCS 1
+#define BYTES  2
+
+int main(int argc, char *argv[])
+{
+	unsigned int seed = DEFAULT_SEED;
+	const char *statesFile = NULL;
+	const char *csvFile = NULL;
+	bool timing = true;
+	
+	int opt;
+	while ((opt = getopt(argc, argv, "ns:o:c:")) != -1) {
+		switch (opt) {
+			case 'n': timing = false;                   break;
+			case 's': seed = strtoul(optarg, NULL, 10); break;
+			case 'o': statesFile = optarg;              break;
+			case 'c': csvFile = optarg;                 break;
+			default:
+				fprintf(stderr, "usage: %s [-n] [-s seed] [-o states.txt] "
+				        "[-c results.csv]\n", argv[0]);
+				exit(EXIT_FAILURE);
+		}
+	}
+	
+	int longest = lengths[NUM_LENGTHS - 1];
+	char *pastPlays = NULL;
+	int numTries = 0;
+	while (pastPlays == NULL && numTries < MAX_TRIES) {
+		Random rng;
+		randomSeed(&rng, seed + numTries++);
+		pastPlays = playGame(longest, &rng);
+	}
+	if (pastPlays == NULL) {
+		fprintf(stderr, "Every game ended early (tried %d seeds)\n",
+		        numTries);
+		exit(EXIT_FAILURE);
+	}
+	seed += numTries - 1;
+	
+	Length ls[NUM_LENGTHS];
+	for (int i = 0; i < NUM_LENGTHS; i++) {
+		Length *l = &ls[i];
+		l->rounds = lengths[i];
+		int numHunterPlays = l->rounds * NUM_PLAYERS;
+		l->draculaPlays = strndup(pastPlays,
+		                          (numHunterPlays - 1) * PLAY_SIZE - 1);
+		l->hunterPlays = hidePlays(pastPlays, numHunterPlays);
+		if (l->draculaPlays == NULL) {
+			fprintf(stderr, "Couldn't allocate states\n");
+			exit(EXIT_FAILURE);
+		}
+		l->gv = GvNew(l->draculaPlays, NULL);
+		l->hv = HvNew(l->hunterPlays, NULL);
+		l->dv = DvNew(l->draculaPlays, NULL);
+	}
+	free(pastPlays);
+	
+	if (statesFile != NULL) {
+		FILE *out = fopen(statesFile, "w");
+		if (out == NULL) {
+			fprintf(stderr, "Couldn't open '%s'\n", statesFile);
+			exit(EXIT_FAILURE);
+		}
+		for (int i = 0; i < NUM_LENGTHS; i++) {
+			fprintf(out, "%s\n%s\n", ls[i].draculaPlays, ls[i].hunterPlays);
+		}
+		fclose(out);
+	}
+	
+	printf("A game of %d rounds (seed %u, %d %s); it would have been over "
+	       "after %d\n\n", longest, seed, numTries,
+	       numTries == 1 ? "try" : "tries", GAME_START_SCORE);
+	fflush(stdout);
+	
+	BenchResult results[NUM_FUNCTIONS][NUM_LENGTHS];
+	for (int f = 0; timing && f < NUM_FUNCTIONS; f++) {
+		for (int i = 0; i < NUM_LENGTHS; i++) {
+			benchMeasure(functions[f].op, &ls[i], 1, &results[f][i]);
+		}
+	}
+	if (timing) {
+		showTable("ns/op", results, functions, NUM_FUNCTIONS, NSECS);
+		showTable("allocs/op", results, functions, NUM_FUNCTIONS, ALLOCS);
+		showTable("bytes/op", results, functions, NUM_FUNCTIONS, BYTES);
+	}
+	
+	if (timing && csvFile != NULL) {
+		FILE *out = fopen(csvFile, "w");
+		if (out == NULL) {
+			fprintf(stderr, "Couldn't open '%s'\n", csvFile);
+			exit(EXIT_FAILURE);
+		}
+		fprintf(out, "impl,function,rounds,ns_per_op,allocs_per_op,"
+		        "bytes_per_op\n");
+		for (int f = 0; f < NUM_FUNCTIONS; f++) {
+			for (int i = 0; i < NUM_LENGTHS; i++) {
+				BenchResult *r = &results[f][i];
+				fprintf(out, "hunt,%s,%d,%.1f,%.2f,%.0f\n", functions[f].name,
+				        lengths[i], r->nsecsPerOp, r->allocsPerOp,
+				        r->bytesPerOp);
+			}
+		}
+		fclose(out);
+	}
+	
+	for (int i = 0; i < NUM_LENGTHS; i++) {
+		GvFree(ls[i].gv);
+		HvFree(ls[i].hv);
+		DvFree(ls[i].dv);
+		free(ls[i].draculaPlays);
+		free(ls[i].hunterPlays);
+	}
+	return EXIT_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Playing the game
+
+/**
+ * Plays a game of numRounds rounds, and returns its pastPlays, or NULL
+ * if the game was over before the score ran out
+ */
+static char *playGame(int numRounds, Random *rng) {
+	char *pastPlays = malloc(numRounds * NUM_PLAYERS * PLAY_SIZE);
+	if (pastPlays == NULL) {
+		fprintf(stderr, "Couldn't allocate pastPlays\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	GenerateOptions options = {
+		.dracula = GENERATE_CAUTIOUS,
+		.hunters = GENERATE_CAUTIOUS,
+	};
+	DraculaView dv = DvNew("", NULL);
+	int numPlays = ((numRounds < GAME_START_SCORE) ? numRounds
+	                                               : GAME_START_SCORE)
+	             * NUM_PLAYERS;
+	int numMade = generatePlays(dv, &options, numPlays, rng, pastPlays);
+	if (numMade == numPlays && numRounds > GAME_START_SCORE) {
+		pastPlays[numMade * PLAY_SIZE - 1] = ' ';
+		options.pastEnd = true;
+		numMade += generatePlays(dv, &options,
+		                         (numRounds - GAME_START_SCORE) * NUM_PLAYERS,
+		                         rng, &pastPlays[numMade * PLAY_SIZE]);
+	}
+	DvFree(dv);
+	
+	if (numMade < numRounds * NUM_PLAYERS) {
+		free(pastPlays);
+		return NULL;
+	}
+	return pastPlays;
+}
+
+/** The first numPlays plays of a game, as the hunters see them */
+static char *hidePlays(const char *pastPlays, int numPlays) {
+	char *hidden = strndup(pastPlays, numPlays * PLAY_SIZE - 1);
+	if (hidden == NULL) {
+		fprintf(stderr, "Couldn't allocate states\n");
+		exit(EXIT_FAILURE);
+	}
+	GameView gv = GvNew(hidden, NULL);
+	generateHunterPlays(gv, hidden, hidden);
+	GvFree(gv);
+	return hidden;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Reporting
+
+static void showTable(const char *title, BenchResult results[][NUM_LENGTHS],
+                      Function functions[], int numFunctions, int metric) {
+	printf("%-32s", title);
+	for (int i = 0; i < NUM_LENGTHS; i++) {
+		printf(" %10d", lengths[i]);
+	}
+	printf(" %8s\n", "growth");
+	
+	for (int f = 0; f < numFunctions; f++) {
+		printf("%-32s", functions[f].name);
+		for (int i = 0; i < NUM_LENGTHS; i++) {
+			printf(" %10.*f", metric == ALLOCS ? 2 : metric == NSECS ? 1 : 0,
+			       metricOf(&results[f][i], metric));
+		}
+		double from = metricOf(&results[f][GROWTH_FROM], metric);
+		double to = metricOf(&results[f][GROWTH_TO], metric);
+		double ratio = (double) lengths[GROWTH_TO] / lengths[GROWTH_FROM];
+		if (from > 0 && to > 0) {
+			printf(" %8.2f\n", log(to / from) / log(ratio));
+		} else {
+			printf(" %8s\n", "-");
+		}
+	}
+	printf("\n");
+	fflush(stdout);
+}
+
+static double metricOf(BenchResult *r, int metric) {
+	switch (metric) {
+		case NSECS:  return r->nsecsPerOp;
+		case ALLOCS: return r->allocsPerOp;
+		default:     return r->bytesPerOp;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// The benchmarks
+
+static void benchGvNew(void *arg, int i) {
+	Length *l = arg;
+	GvFree(GvNew(l->draculaPlays, NULL));
+}
+
+static void benchGvGetMoveHistory(void *arg, int i) {
+	Length *l = arg;
+	int numMoves = 0;
+	bool canFree = false;
+	PlaceId *moves = GvGetMoveHistory(l->gv, PLAYER_DRACULA, &numMoves,
+	                                  &canFree);
+	if (canFree) free(moves);
+}
+
+static void benchGvGetLocationHistory(void *arg, int i) {
+	Length *l = arg;
+	int numLocs = 0;
+	bool canFree = false;
+	PlaceId *locs = GvGetLocationHistory(l->gv, PLAYER_DRACULA, &numLocs,
+	                                     &canFree);
+	if (canFree) free(locs);
+}
+
+static void benchGvGetLastMoves(void *arg, int i) {
+	Length *l = arg;
+	int numMoves = 0;
+	bool canFree = false;
+	PlaceId *moves = GvGetLastMoves(l->gv, PLAYER_DRACULA, TRAIL_SIZE,
+	                                &numMoves, &canFree);
+	if (canFree) free(moves);
+}
+
+static void benchGvGetTrapLocations(void *arg, int i) {
+	Length *l = arg;
+	int numTraps = 0;
+	free(GvGetTrapLocations(l->gv, &numTraps));
+}
+
+static void benchGvGetReachableByType(void *arg, int i) {
+	Length *l = arg;
+	PlaceId from = GvGetPlayerLocation(l->gv, PLAYER_LORD_GODALMING);
+	int numLocs = 0;
+	free(GvGetReachableByType(l->gv, PLAYER_LORD_GODALMING, l->rounds,
+	                          from, true, true, true, &numLocs));
+}
+
+static void benchHvNew(void *arg, int i) {
+	Length *l = arg;
+	HvFree(HvNew(l->hunterPlays, NULL));
+}
+
+static void benchHvGetLastKnownDraculaLocation(void *arg, int i) {
+	Length *l = arg;
+	Round round = 0;
+	HvGetLastKnownDraculaLocation(l->hv, &round);
+}
+
+static void benchHvGetShortestPathTo(void *arg, int i) {
+	static PlaceId dest = 0;
+	Length *l = arg;
+	int pathLength = 0;
+	free(HvGetShortestPathTo(l->hv, PLAYER_LORD_GODALMING, dest,
+	                         &pathLength));
+	dest = (dest + 1) % NUM_REAL_PLACES;
+}
+
+static void benchDvNew(void *arg, int i) {
+	Length *l = arg;
+	DvFree(DvNew(l->draculaPlays, NULL));
+}
+
+static void benchDvGetValidMoves(void *arg, int i) {
+	Length *l = arg;
+	int numMoves = 0;
+	free(DvGetValidMoves(l->dv, &numMoves));
+}
+
+static void benchDvWhereCanTheyGoByType(void *arg, int i) {
+	Length *l = arg;
+	int numLocs = 0;
+	free(DvWhereCanTheyGoByType(l->dv, PLAYER_LORD_GODALMING,
+	                            true, true, true, &numLocs));
+}
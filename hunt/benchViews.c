@@ -0,0 +1,226 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// benchViews.c: time the view functions the AIs call most
+//
+// Runs each function on every state in pastPlays.txt and in the
+// recorded games (corpus.replay, made by corpus from OUTPUT.txt), and
+// reports the time and allocations per call (see Bench.h). It also
+// times generatePlays making one play at a time, from the start of a
+// game until it's over and round again. Run it with `make bench`, or
+//
+// Usage: ./benchViews [pastPlays.txt] [file.replay]
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Bench.h"
+#include "DraculaView.h"
+#include "Game.h"
+#include "GameView.h"
+#include "Generate.h"
+#include "HunterView.h"
+#include "Map.h"
+#include "Places.h"
+#include "Random.h"
+
+#define DEFAULT_PAST_PLAYS "pastPlays.txt"
+#define DEFAULT_REPLAY     "corpus.replay"
+
+// The states, and views of them, for the functions that need views
+typedef struct views {
+	BenchState  *states;
+	int          numStates;
+	
+	// Every state in which the player whose turn it is has moved
+	GameView    *gvs;
+	BenchState **gvStates;
+	int          numGvs;
+	
+	// Every hunter's turn after the first round
+	HunterView  *hvs;
+	BenchState **hvStates;
+	int          numHvs;
+	
+	// Every one of Dracula's turns
+	DraculaView *dvs;
+	int          numDvs;
+} Views;
+
+// A game being generated a play at a time
+typedef struct generator {
+	GenerateOptions options;
+	DraculaView     dv;
+	Random          rng;
+} Generator;
+
+static void buildViews(Views *v);
+static void freeViews(Views *v);
+
+static void benchGvNew(void *arg, int i);
+static void benchGvGetReachableByType(void *arg, int i);
+static void benchHvGetShortestPathTo(void *arg, int i);
+static void benchHvGetLastKnownDraculaLocation(void *arg, int i);
+static void benchDvGetValidMoves(void *arg, int i);
+static void benchDvWhereCanTheyGoByType(void *arg, int i);
+static void benchPlaceAbbrevToId(void *arg, int i);
+static void benchMapNew(void *arg, int i);
+static void benchGeneratePlays(void *arg, int i);
+
+int main(int argc, char *argv[])
+{
+	const char *pastPlaysFile = (argc > 1) ? argv[1] : DEFAULT_PAST_PLAYS;
+	const char *replayFile = (argc > 2) ? argv[2] : DEFAULT_REPLAY;
+	
+	Views v = {};
+	v.states = benchLoadStates(pastPlaysFile, replayFile, &v.numStates);
+	if (v.numStates == 0) {
+		fprintf(stderr, "No states to run on\n");
+		exit(EXIT_FAILURE);
+	}
+	buildViews(&v);
+	printf("%d states (%d hunter, %d Dracula)\n\n",
+	       v.numStates, v.numHvs, v.numDvs);
+	
+	benchShowHeader();
+	benchRun("GvNew", benchGvNew, &v, v.numStates);
+	benchRun("GvGetReachableByType", benchGvGetReachableByType,
+	         &v, v.numGvs);
+	benchRun("HvGetShortestPathTo", benchHvGetShortestPathTo,
+	         &v, v.numHvs);
+	benchRun("HvGetLastKnownDraculaLocation",
+	         benchHvGetLastKnownDraculaLocation, &v, v.numHvs);
+	benchRun("DvGetValidMoves", benchDvGetValidMoves, &v, v.numDvs);
+	benchRun("DvWhereCanTheyGoByType", benchDvWhereCanTheyGoByType,
+	         &v, v.numDvs * NUM_PLAYERS);
+	benchRun("placeAbbrevToId", benchPlaceAbbrevToId, NULL,
+	         NUM_REAL_PLACES);
+	benchRun("MapNew", benchMapNew, NULL, 1);
+	
+	GeneratePolicy policies[] = {
+		GENERATE_UNIFORM, GENERATE_GREEDY, GENERATE_CAUTIOUS
+	};
+	const char *names[] = {
+		"generatePlays (uniform)", "generatePlays (greedy)",
+		"generatePlays (cautious)"
+	};
+	for (int p = 0; p < 3; p++) {
+		Generator g = {
+			.options = { .dracula = policies[p], .hunters = policies[p] },
+			.dv = DvNew("", NULL),
+		};
+		randomSeed(&g.rng, 1);
+		benchRun(names[p], benchGeneratePlays, &g, 1);
+		DvFree(g.dv);
+	}
+	
+	freeViews(&v);
+	benchFreeStates(v.states, v.numStates);
+	return EXIT_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////
+
+static void buildViews(Views *v) {
+	v->gvs = malloc(v->numStates * sizeof(GameView));
+	v->gvStates = malloc(v->numStates * sizeof(BenchState *));
+	v->hvs = malloc(v->numStates * sizeof(HunterView));
+	v->hvStates = malloc(v->numStates * sizeof(BenchState *));
+	v->dvs = malloc(v->numStates * sizeof(DraculaView));
+	if (v->gvs == NULL || v->gvStates == NULL || v->hvs == NULL
+	        || v->hvStates == NULL || v->dvs == NULL) {
+		fprintf(stderr, "Couldn't allocate views\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	for (int i = 0; i < v->numStates; i++) {
+		BenchState *state = &v->states[i];
+		GameView gv = GvNew(state->pastPlays, NULL);
+		if (placeIsReal(GvGetPlayerLocation(gv, state->player))) {
+			v->gvStates[v->numGvs] = state;
+			v->gvs[v->numGvs++] = gv;
+		} else {
+			GvFree(gv);
+		}
+		
+		if (state->player == PLAYER_DRACULA) {
+			v->dvs[v->numDvs++] = DvNew(state->pastPlays, NULL);
+		} else if (state->round > 0) {
+			v->hvStates[v->numHvs] = state;
+			v->hvs[v->numHvs++] = HvNew(state->pastPlays, NULL);
+		}
+	}
+}
+
+static void freeViews(Views *v) {
+	for (int i = 0; i < v->numGvs; i++) GvFree(v->gvs[i]);
+	for (int i = 0; i < v->numHvs; i++) HvFree(v->hvs[i]);
+	for (int i = 0; i < v->numDvs; i++) DvFree(v->dvs[i]);
+	free(v->gvs);
+	free(v->gvStates);
+	free(v->hvs);
+	free(v->hvStates);
+	free(v->dvs);
+}
+
+////////////////////////////////////////////////////////////////////////
+// The benchmarks
+
+static void benchGvNew(void *arg, int i) {
+	Views *v = arg;
+	GvFree(GvNew(v->states[i].pastPlays, NULL));
+}
+
+static void benchGvGetReachableByType(void *arg, int i) {
+	Views *v = arg;
+	BenchState *state = v->gvStates[i];
+	PlaceId from = GvGetPlayerLocation(v->gvs[i], state->player);
+	int numLocs = 0;
+	free(GvGetReachableByType(v->gvs[i], state->player, state->round,
+	                          from, true, true, true, &numLocs));
+}
+
+static void benchHvGetShortestPathTo(void *arg, int i) {
+	Views *v = arg;
+	int pathLength = 0;
+	free(HvGetShortestPathTo(v->hvs[i], v->hvStates[i]->player,
+	                         i % NUM_REAL_PLACES, &pathLength));
+}
+
+static void benchHvGetLastKnownDraculaLocation(void *arg, int i) {
+	Views *v = arg;
+	Round round = 0;
+	HvGetLastKnownDraculaLocation(v->hvs[i], &round);
+}
+
+static void benchDvGetValidMoves(void *arg, int i) {
+	Views *v = arg;
+	int numMoves = 0;
+	free(DvGetValidMoves(v->dvs[i], &numMoves));
+}
+
+static void benchDvWhereCanTheyGoByType(void *arg, int i) {
+	Views *v = arg;
+	int numLocs = 0;
+	free(DvWhereCanTheyGoByType(v->dvs[i / NUM_PLAYERS], i % NUM_PLAYERS,
+	                            true, true, true, &numLocs));
+}
+
+static void benchPlaceAbbrevToId(void *arg, int i) {
+	placeAbbrevToId((char *) placeIdToAbbrev(i));
+}
+
+static void benchMapNew(void *arg, int i) {
+	MapFree(MapNew());
+}
+
+static void benchGeneratePlays(void *arg, int i) {
+	Generator *g = arg;
+	char play[8];
+	if (generatePlays(g->dv, &g->options, 1, &g->rng, play) == 0) {
+		DvFree(g->dv);
+		g->dv = DvNew("", NULL);
+	}
+}
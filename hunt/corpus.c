@@ -0,0 +1,362 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// corpus.c: turn game engine logs into a replay file
+//
+// Reads the logs the game engine writes (like OUTPUT.txt), which show
+// every turn's input as a line
+//     Running with input: "past_plays": "GMN.... SGA...."
+// and end each game with its revealedPastPlays, final score and final
+// round, and writes all the games in them to one replay file (see
+// Replay.h). The hunters' inputs say what they were shown of Dracula's
+// moves, and when they were shown where he really went, so the replay
+// can give back every turn's input exactly; each one is checked against
+// the log once the file's written.
+//
+// Usage: ./corpus [-o file.replay] LOG...
+//     -o file  the replay file to write (default corpus.replay)
+//
+// A game the log doesn't finish is left out.
+//
+////////////////////////////////////////////////////////////////////////
+
+#define _GNU_SOURCE
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "Game.h"
+#include "Replay.h"
+
+#define DEFAULT_OUTPUT  "corpus.replay"
+
+#define INPUT_PREFIX    "Running with input: \"past_plays\": \""
+#define REVEALED_PREFIX "  revealedPastPlays: "
+#define SCORE_PREFIX    "Final score: "
+#define ROUND_PREFIX    "Final round: "
+
+// Where Dracula's location is, in one of his plays
+#define LOCATION        1
+
+// Everything the log says about one game
+typedef struct loggedGame {
+	char **inputs;       // each turn's past_plays, in order
+	int    numInputs;
+	int    maxInputs;
+	char  *pastPlays;    // every play, as Dracula saw it
+	int    score;
+	int    round;        // -1 until the game's over
+} LoggedGame;
+
+typedef struct corpus {
+	ReplayWriter rw;
+	LoggedGame  *games;
+	int          numGames;
+	int          maxGames;
+	int          numSkipped;
+} Corpus;
+
+static void readLog(Corpus *c, const char *filename);
+static void stripColours(char *line);
+static LoggedGame *newGame(Corpus *c);
+static void dropGame(Corpus *c);
+static void addInput(LoggedGame *game, const char *input);
+static bool writeGame(Corpus *c, LoggedGame *game);
+static bool findReveals(LoggedGame *game, ReplayReveal reveals[]);
+static bool isDraculaLocation(int i);
+static int checkReplay(Corpus *c, const char *filename);
+static void freeGame(LoggedGame *game);
+static void *growArray(void *array, int *max, size_t size);
+
+int main(int argc, char *argv[])
+{
+	const char *output = DEFAULT_OUTPUT;
+	
+	int opt;
+	while ((opt = getopt(argc, argv, "o:")) != -1) {
+		switch (opt) {
+			case 'o': output = optarg; break;
+			default:
+				fprintf(stderr, "usage: %s [-o file.replay] LOG...\n",
+				        argv[0]);
+				exit(EXIT_FAILURE);
+		}
+	}
+	if (optind == argc) {
+		fprintf(stderr, "usage: %s [-o file.replay] LOG...\n", argv[0]);
+		exit(EXIT_FAILURE);
+	}
+	
+	Corpus c = { .rw = ReplayWriterNew(output) };
+	for (int i = optind; i < argc; i++) {
+		readLog(&c, argv[i]);
+	}
+	ReplayWriterFree(c.rw);
+	
+	int numMismatches = checkReplay(&c, output);
+	
+	long numPositions = 0;
+	for (int i = 0; i < c.numGames; i++) {
+		numPositions += c.games[i].numInputs;
+		freeGame(&c.games[i]);
+	}
+	free(c.games);
+	
+	printf("Wrote %d games (%ld positions) to '%s'",
+	       c.numGames, numPositions, output);
+	if (c.numSkipped > 0) printf(", skipped %d", c.numSkipped);
+	printf("\n");
+	
+	if (numMismatches > 0) {
+		fprintf(stderr, "%d inputs didn't match the log\n", numMismatches);
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Reading the logs
+
+/**
+ * Reads every game in a log. A game starts with an empty past_plays,
+ * and ends with its final round.
+ */
+static void readLog(Corpus *c, const char *filename) {
+	FILE *log = fopen(filename, "r");
+	if (log == NULL) {
+		fprintf(stderr, "Couldn't open '%s'\n", filename);
+		exit(EXIT_FAILURE);
+	}
+	
+	LoggedGame *game = NULL;
+	char *line = NULL;
+	size_t size = 0;
+	while (getline(&line, &size, log) != -1) {
+		stripColours(line);
+		line[strcspn(line, "\r\n")] = '\0';
+		
+		if (strncmp(line, INPUT_PREFIX, strlen(INPUT_PREFIX)) == 0) {
+			char *input = line + strlen(INPUT_PREFIX);
+			input[strcspn(input, "\"")] = '\0';
+			if (input[0] == '\0') {
+				if (game != NULL) dropGame(c);
+				game = newGame(c);
+			}
+			if (game != NULL) addInput(game, input);
+		
+		} else if (game == NULL) {
+			continue;
+		
+		} else if (strncmp(line, REVEALED_PREFIX,
+		                   strlen(REVEALED_PREFIX)) == 0) {
+			game->pastPlays = strdup(line + strlen(REVEALED_PREFIX));
+		
+		} else if (strncmp(line, SCORE_PREFIX, strlen(SCORE_PREFIX)) == 0) {
+			game->score = atoi(line + strlen(SCORE_PREFIX));
+		
+		} else if (strncmp(line, ROUND_PREFIX, strlen(ROUND_PREFIX)) == 0) {
+			game->round = atoi(line + strlen(ROUND_PREFIX));
+			if (!writeGame(c, game)) dropGame(c);
+			game = NULL;
+		}
+	}
+	if (game != NULL) dropGame(c);
+	
+	free(line);
+	fclose(log);
+}
+
+/**
+ * Takes out the terminal colour codes, e.g. "\033[0;36m"
+ */
+static void stripColours(char *line) {
+	char *out = line;
+	for (char *in = line; *in != '\0'; in++) {
+		if (*in == '\033' && in[1] == '[') {
+			in += 2;
+			while (*in != '\0' && *in != 'm') in++;
+			if (*in == '\0') break;
+		} else {
+			*out++ = *in;
+		}
+	}
+	*out = '\0';
+}
+
+static LoggedGame *newGame(Corpus *c) {
+	if (c->numGames == c->maxGames) {
+		c->games = growArray(c->games, &c->maxGames, sizeof(LoggedGame));
+	}
+	LoggedGame *game = &c->games[c->numGames++];
+	*game = (LoggedGame) { .round = -1 };
+	return game;
+}
+
+/**
+ * Forgets the last game, which the log didn't finish, or which couldn't
+ * be written
+ */
+static void dropGame(Corpus *c) {
+	freeGame(&c->games[--c->numGames]);
+	c->numSkipped++;
+}
+
+static void addInput(LoggedGame *game, const char *input) {
+	if (game->numInputs == game->maxInputs) {
+		game->inputs = growArray(game->inputs, &game->maxInputs,
+		                         sizeof(char *));
+	}
+	game->inputs[game->numInputs] = strdup(input);
+	if (game->inputs[game->numInputs] == NULL) {
+		fprintf(stderr, "Couldn't allocate input\n");
+		exit(EXIT_FAILURE);
+	}
+	game->numInputs++;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Writing the replay
+
+static bool writeGame(Corpus *c, LoggedGame *game) {
+	if (game->pastPlays == NULL) {
+		fprintf(stderr, "Game %d has no revealedPastPlays\n", c->numGames);
+		return false;
+	}
+	
+	int numPlays = (strlen(game->pastPlays) + 1) / REPLAY_RECORD_SIZE;
+	ReplayReveal *reveals = malloc((numPlays / NUM_PLAYERS + 1)
+	                               * sizeof(ReplayReveal));
+	if (reveals == NULL) {
+		fprintf(stderr, "Couldn't allocate reveals\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	bool matches = findReveals(game, reveals);
+	if (matches) {
+		ReplayWriterAddGame(c->rw, game->pastPlays, reveals,
+		                    game->score, game->round);
+	} else {
+		fprintf(stderr, "Game %d doesn't match its revealedPastPlays\n",
+		        c->numGames);
+	}
+	free(reveals);
+	return matches;
+}
+
+/**
+ * Works out what the hunters were shown of each of Dracula's plays, and
+ * when they first saw where he really went. Returns false if an input
+ * isn't the start of the game's plays, apart from what was hidden.
+ */
+static bool findReveals(LoggedGame *game, ReplayReveal reveals[]) {
+	const char *plays = game->pastPlays;
+	int numPlays = (strlen(plays) + 1) / REPLAY_RECORD_SIZE;
+	
+	// Until the hunters see one, assume they'd be shown the truth
+	for (int p = PLAYER_DRACULA; p < numPlays; p += NUM_PLAYERS) {
+		const char *location = plays + p * REPLAY_RECORD_SIZE + LOCATION;
+		reveals[p / NUM_PLAYERS] = (ReplayReveal) {
+			.shown = { location[0], location[1] },
+			.revealedAt = REPLAY_NEVER,
+		};
+	}
+	
+	for (int i = 0; i < game->numInputs; i++) {
+		const char *input = game->inputs[i];
+		int length = strlen(input);
+		int play = (length + 1) / REPLAY_RECORD_SIZE;
+		if (play > numPlays) return false;
+		
+		bool isHunter = play % NUM_PLAYERS != PLAYER_DRACULA;
+		for (int j = 0; j < length; j++) {
+			if (input[j] != plays[j]
+			        && !(isHunter && isDraculaLocation(j))) {
+				return false;
+			}
+		}
+		if (!isHunter) continue;
+		
+		for (int p = PLAYER_DRACULA; p < play; p += NUM_PLAYERS) {
+			ReplayReveal *reveal = &reveals[p / NUM_PLAYERS];
+			const char *shown = input + p * REPLAY_RECORD_SIZE + LOCATION;
+			const char *real = plays + p * REPLAY_RECORD_SIZE + LOCATION;
+			if (strncmp(shown, real, 2) != 0) {
+				reveal->shown[0] = shown[0];
+				reveal->shown[1] = shown[1];
+			} else if (reveal->revealedAt > play) {
+				reveal->revealedAt = play;
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * Whether the i'th character of a pastPlays string is part of the
+ * location in one of Dracula's plays
+ */
+static bool isDraculaLocation(int i) {
+	int offset = i % REPLAY_RECORD_SIZE;
+	return i / REPLAY_RECORD_SIZE % NUM_PLAYERS == PLAYER_DRACULA
+	    && offset >= LOCATION && offset < LOCATION + 2;
+}
+
+/**
+ * Reads the replay back, and counts the inputs it doesn't give back
+ * exactly
+ */
+static int checkReplay(Corpus *c, const char *filename) {
+	Replay rp = ReplayOpen(filename);
+	if (rp == NULL) {
+		fprintf(stderr, "Couldn't read back '%s'\n", filename);
+		exit(EXIT_FAILURE);
+	}
+	
+	int numMismatches = 0;
+	for (int i = 0; i < c->numGames; i++) {
+		LoggedGame *game = &c->games[i];
+		int numPlays = ReplayNumPlays(rp, i);
+		char *pastPlays = malloc(numPlays * REPLAY_RECORD_SIZE + 1);
+		if (pastPlays == NULL) {
+			fprintf(stderr, "Couldn't allocate pastPlays\n");
+			exit(EXIT_FAILURE);
+		}
+		for (int j = 0; j < game->numInputs; j++) {
+			const char *input = game->inputs[j];
+			int play = (strlen(input) + 1) / REPLAY_RECORD_SIZE;
+			if (play <= numPlays) {
+				ReplayGetPastPlays(rp, i, play, pastPlays);
+			}
+			if (play > numPlays || strcmp(input, pastPlays) != 0) {
+				fprintf(stderr, "Game %d, play %d doesn't match\n", i, play);
+				numMismatches++;
+			}
+		}
+		free(pastPlays);
+	}
+	
+	ReplayClose(rp);
+	return numMismatches;
+}
+
+////////////////////////////////////////////////////////////////////////
+
+static void freeGame(LoggedGame *game) {
+	for (int i = 0; i < game->numInputs; i++) {
+		free(game->inputs[i]);
+	}
+	free(game->inputs);
+	free(game->pastPlays);
+}
+
+static void *growArray(void *array, int *max, size_t size) {
+	*max = (*max == 0) ? 16 : *max * 2;
+	array = realloc(array, *max * size);
+	if (array == NULL) {
+		fprintf(stderr, "Couldn't grow array\n");
+		exit(EXIT_FAILURE);
+	}
+	return array;
+}
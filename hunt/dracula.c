@@ -9,6 +9,10 @@
 //
 ////////////////////////////////////////////////////////////////////////
 #include "dracula.h"
+#include "Arena.h"
+#include "Decision.h"
+#include "DraculaMcts.h"
+#include "Parallel.h"
 #include "DraculaView.h"
 #include "Game.h"
 #include "Map.h"
@@ -19,6 +23,17 @@
 #include <stdlib.h>
 
 #define NUM_PORT_CITIES 28
+
+// Each part of the strategy says something different with its move, so
+// a log (or benchDecisions) shows which part made it
+#define START_MESSAGE    "liam neesons --Start--"
+#define TELEPORT_MESSAGE "liam neesons i am neesons"
+#define CASTLE_MESSAGE   "liam neesons? --Castle--"
+#define LOOP_MESSAGE     "liam neesons --Loop--"
+#define RISK_MESSAGE     "liam neesons --Risk--"
+#define SEARCH_MESSAGE   "liam neesons --Search--"
+#define VALID_MESSAGE    "liam neesons --Valid--"
+
 #define SIZE_OF_ENGLAND 7
 #define SIZE_OF_SPAIN 11
 #define SIZE_OF_ITALY 7
@@ -64,7 +79,73 @@ int huntersInCountry (PlaceId country[], PlaceId hunterLocs[], int size);
 int isDoubleBack(PlaceId location);
 bool isCountry (PlaceId country[], PlaceId location, int size);
 bool LoopStrat(PlaceId *pastLocs, PlaceId *validMoves, int numValidMoves, int numPastLocs, PlaceId hunterLocs[]);
+static void decideRiskMove(DraculaView dv);
+static void decideSearchMove(DraculaView dv);
+static void registerRiskPlay(char *play, Message message);
+
+// The move decideRiskMove registered, so it can be checked
+static __thread char riskPlay[3] = "";
+
 void decideDraculaMove(DraculaView dv)
+{
+	// The arrays the views give back while deciding all go at the end
+	Arena arena = decisionArena();
+	Arena previous = ArenaUse(arena);
+
+	// Register the risk-based move straight away, so there's always a
+	// move even if the search is cut short
+	riskPlay[0] = '\0';
+	decideRiskMove(dv);
+	decideSearchMove(dv);
+
+	ArenaUse(previous);
+	ArenaReset(arena);
+}
+
+// Searches for as long as the turn allows (or for the fixed number of
+// iterations, see Decision.h), unless there's no choice to make (the
+// opening and teleports are left to the risk-based moves). The
+// risk-based move isn't always valid, so it's replaced by one that is
+// before searching, in case the search is cut short.
+static void decideSearchMove(DraculaView dv)
+{
+	PlaceId validMoves[NUM_REAL_PLACES];
+	int numValidMoves = DvFillValidMoves(dv, validMoves);
+	if (numValidMoves == 0) return;
+
+	if (riskPlay[0] == '\0' ||
+	    !isValid(riskPlay, validMoves, numValidMoves)) {
+		// Keep to where it wanted to go if a valid move gets there
+		PlaceId wanted = placeAbbrevToId(riskPlay);
+		PlaceId move = validMoves[0];
+		for (int i = 0; i < numValidMoves; i++) {
+			if (DvResolveMove(dv, validMoves[i]) == wanted) {
+				move = validMoves[i];
+				break;
+			}
+		}
+		decisionPublish(move, VALID_MESSAGE);
+	}
+	if (numValidMoves == 1) return;
+
+	MctsMoveStats stats[NUM_REAL_PLACES];
+	int numMoves = DmSearchParallel(dv, decisionSeed(),
+	                                parallelNumThreads(), decisionIterations(),
+	                                stats);
+	PlaceId move = parallelBestMove(stats, numMoves);
+	if (move != NOWHERE) decisionPublish(move, SEARCH_MESSAGE);
+}
+
+// Registers one of decideRiskMove's plays, and remembers it
+static void registerRiskPlay(char *play, Message message)
+{
+	strncpy(riskPlay, play, sizeof(riskPlay) - 1);
+	riskPlay[sizeof(riskPlay) - 1] = '\0';
+	registerBestPlay(play, message);
+}
+
+// Picks the valid move with the lowest risk of running into hunters
+static void decideRiskMove(DraculaView dv)
 {
 	PlaceId currLoc = DvGetPlayerLocation(dv, PLAYER_DRACULA); // Dracula's current location.
 	int health = DvGetHealth(dv, PLAYER_DRACULA); // Dracula's Blood Points.
@@ -86,34 +167,34 @@ void decideDraculaMove(DraculaView dv)
 	// Round 0 Move
 	if (round == 0) {
 		if (huntersNearCD(hunterLocs) <= 1) {
-			registerBestPlay("CD", "liam neesons"); 
+			registerRiskPlay("CD", START_MESSAGE); 
 			return;
 		}
 		else {
 			for (int player = 0; player < 4; player++) {
 				if (hunterLocs[player] == STRASBOURG) {
-					registerBestPlay("AL", "liam neesons"); 
+					registerRiskPlay("AL", START_MESSAGE); 
 					return;
 				}
 			}
-		 	registerBestPlay("ST", "liam neesons"); 
+		 	registerRiskPlay("ST", START_MESSAGE); 
 			return;
 		}
 	}
 
 	// Round 1 Move
 	if (round == 1 && pastLocs[0] == CASTLE_DRACULA) {
-		if (huntersNearCD(hunterLocs) <= 1) registerBestPlay("D1", "liam neesons"); return;
+		if (huntersNearCD(hunterLocs) <= 1) registerRiskPlay("D1", START_MESSAGE); return;
 	}
 
 	// Round 2 Move
 	if (round == 2 && pastLocs[0] == CASTLE_DRACULA) {
-		if (huntersNearCD(hunterLocs) <= 1) registerBestPlay("HI", "liam neesons"); return;
+		if (huntersNearCD(hunterLocs) <= 1) registerRiskPlay("HI", START_MESSAGE); return;
 	}
 	
 	// If Dracula has no valid moves, use TELEPORT.
 	if (validMoves == NULL) { 
-		registerBestPlay("TP", "liam neesons i am neesons"); 
+		registerRiskPlay("TP", TELEPORT_MESSAGE); 
 		return;
 	}
 
@@ -296,7 +377,7 @@ void decideDraculaMove(DraculaView dv)
 
 	// FIND THE MOVES WITH THE MINIMUM RISK LEVEL
 	int min = riskLevel[MoveToLoc(pastLocs, validMoves[numValidMoves - 1], &numPastLocs)];
-	PlaceId *lowRiskMoves = malloc(sizeof(PlaceId) *numValidMoves);
+	PlaceId lowRiskMoves[NUM_REAL_PLACES];
 	int lowRiskNum = 0;
 
 	for (int i = 0; i < numValidMoves; i++) {
@@ -311,7 +392,7 @@ void decideDraculaMove(DraculaView dv)
 	// If there are no low risk moves pick a random valid move.
 	if (lowRiskNum == 0) {
 		// strcpy(play, placeIdToAbbrev(validMoves[0]));
-		registerBestPlay(strdup(placeIdToAbbrev(validMoves[0])), "liam neesons");
+		registerRiskPlay((char *) placeIdToAbbrev(validMoves[0]), RISK_MESSAGE);
 		return;
 	}
 
@@ -326,8 +407,7 @@ void decideDraculaMove(DraculaView dv)
 
 	// If the minimum hasn't been found, pick the first lowRiskMove.
 	if (minimum == -1) minimum = lowRiskMoves[0];
-	registerBestPlay(strdup(placeIdToAbbrev(minimum)), "liam neesons");
-	free(lowRiskMoves);
+	registerRiskPlay((char *) placeIdToAbbrev(minimum), RISK_MESSAGE);
 	return;
 }
 
@@ -427,57 +507,57 @@ bool isValid (char *play, PlaceId *validMoves, int numValidMoves) {
 bool LoopStrat(PlaceId *pastLocs, PlaceId *validMoves, int numValidMoves, int numPastLocs, PlaceId hunterLocs[]) {
 	if (pastLocs[numPastLocs - 1] == KLAUSENBURG) {
 		if (isValid("CD", validMoves, numValidMoves)) {
-			registerBestPlay("CD", "liam neesons");
+			registerRiskPlay("CD", LOOP_MESSAGE);
 			return true;
 		}
 	}
 	if (pastLocs[numPastLocs - 1] == CASTLE_DRACULA) {
 		if (isValid("GA", validMoves, numValidMoves)) {
-			registerBestPlay("GA", "liam neesons");
+			registerRiskPlay("GA", LOOP_MESSAGE);
 			return true;
 		}
 	}
 	if (pastLocs[numPastLocs - 1] == GALATZ) {
 		if (isValid("CN", validMoves, numValidMoves)) {
-			registerBestPlay("CN", "liam neesons");
+			registerRiskPlay("CN", LOOP_MESSAGE);
 			return true;
 		}
 	}
 	if (pastLocs[numPastLocs - 1] == CONSTANTA) {
 		if (isValid("BS", validMoves, numValidMoves)) {
-			registerBestPlay("BS", "liam neesons");
+			registerRiskPlay("BS", LOOP_MESSAGE);
 			return true;
 		}
 	}
 	if (pastLocs[numPastLocs - 1] == BLACK_SEA) {
 		if (isValid("IO", validMoves, numValidMoves)) {
-			registerBestPlay("IO", "liam neesons");
+			registerRiskPlay("IO", LOOP_MESSAGE);
 			return true;
 		}
 	}
 	if (pastLocs[numPastLocs - 1] == IONIAN_SEA) {
 		if (isValid("TS", validMoves, numValidMoves)) {
-			registerBestPlay("TS", "liam neesons");
+			registerRiskPlay("TS", LOOP_MESSAGE);
 			return true;
 		}
 	}
 	if (pastLocs[numPastLocs - 1] == TYRRHENIAN_SEA) {
 		if (isValid("MS", validMoves, numValidMoves)) {
-			registerBestPlay("MS", "liam neesons");
+			registerRiskPlay("MS", LOOP_MESSAGE);
 			return true;
 		}
 	}
 	if (pastLocs[numPastLocs - 1] == ALICANTE) {
 		if (huntersInCountry(Spain, hunterLocs, SIZE_OF_SPAIN) >= 1) {
 			if (isValid("MS", validMoves, numValidMoves)) {
-				registerBestPlay("MS", "liam neesons");
+				registerRiskPlay("MS", LOOP_MESSAGE);
 				return true;
 			} 
 		}
 		for (int player = 0; player < 4; player++) {
 			if (hunterLocs[player] == MEDITERRANEAN_SEA) {
 				if (isValid("MS", validMoves, numValidMoves)) {
-					registerBestPlay("MS", "liam neesons");
+					registerRiskPlay("MS", LOOP_MESSAGE);
 					return true;
 				}
 			}
@@ -486,13 +566,13 @@ bool LoopStrat(PlaceId *pastLocs, PlaceId *validMoves, int numValidMoves, int nu
 			if (hunterLocs[player] == BORDEAUX || hunterLocs[player] == TOULOUSE
 				|| hunterLocs[player] == BARCELONA) {
 				if (isValid("GR", validMoves, numValidMoves)) {
-					registerBestPlay("GR", "liam neesons");
+					registerRiskPlay("GR", LOOP_MESSAGE);
 					return true;
 				}
 			}
 		}
 		if (isValid("SR", validMoves, numValidMoves)) {
-			registerBestPlay("SR", "liam neesons");
+			registerRiskPlay("SR", LOOP_MESSAGE);
 			return true;
 		}
 	} 
@@ -501,7 +581,7 @@ bool LoopStrat(PlaceId *pastLocs, PlaceId *validMoves, int numValidMoves, int nu
 			for (int player = 0; player < 4; player++) {
 				if (hunterLocs[player] == TOULOUSE || hunterLocs[player] == MEDITERRANEAN_SEA) {
 					if (isValid("SN", validMoves, numValidMoves)) {
-						registerBestPlay("SN", "liam neesons");
+						registerRiskPlay("SN", LOOP_MESSAGE);
 						return true;
 					}
 				}
@@ -514,44 +594,44 @@ bool LoopStrat(PlaceId *pastLocs, PlaceId *validMoves, int numValidMoves, int nu
 				}
 			}
 			if (canGo && isValid("BA", validMoves, numValidMoves)) {
-				registerBestPlay("BA", "liam neesons");
+				registerRiskPlay("BA", LOOP_MESSAGE);
 				return true;
 			}
 		}
 		for (int player = 0; player < 4; player++) {
 			if (hunterLocs[player] == MADRID || hunterLocs[player] == LISBON || hunterLocs[player] == BARCELONA) {
 				if (isValid("BO", validMoves, numValidMoves)) {
-					registerBestPlay("BO", "liam neesons");
+					registerRiskPlay("BO", LOOP_MESSAGE);
 					return true;
 				}
 			}
 		}
 		if (isValid("MA", validMoves, numValidMoves)) {
-			registerBestPlay("MA", "liam neesons");
+			registerRiskPlay("MA", LOOP_MESSAGE);
 			return true;
 		}
 	} 	
 	if (pastLocs[numPastLocs - 1] == BORDEAUX) {
 		if (isValid("BB", validMoves, numValidMoves)) {
-			registerBestPlay("BB", "liam neesons");
+			registerRiskPlay("BB", LOOP_MESSAGE);
 			return true;
 		}
 	} 
 	if (pastLocs[numPastLocs - 1] == BARCELONA) {
 		if (isValid("MS", validMoves, numValidMoves)) {
-			registerBestPlay("MS", "liam neesons");
+			registerRiskPlay("MS", LOOP_MESSAGE);
 			return true;
 		}
 	} 
 	if (pastLocs[numPastLocs - 1] == MADRID) {
 		if ((huntersInCountry(Spain, hunterLocs, SIZE_OF_SPAIN) + huntersInCountry(France, hunterLocs, SIZE_OF_FRANCE)) >= 1) {
 			if (isValid("SN", validMoves, numValidMoves)) {
-				registerBestPlay("SN", "liam neesons");
+				registerRiskPlay("SN", LOOP_MESSAGE);
 				return true;
 			}
 		}
 		if (isValid("LS", validMoves, numValidMoves)) {
-			registerBestPlay("LS", "liam neesons");
+			registerRiskPlay("LS", LOOP_MESSAGE);
 			return true;
 		}
 	} 
@@ -559,18 +639,18 @@ bool LoopStrat(PlaceId *pastLocs, PlaceId *validMoves, int numValidMoves, int nu
 		if (huntersInCountry(Spain, hunterLocs, SIZE_OF_SPAIN) + 
 		huntersInCountry(France, hunterLocs, SIZE_OF_FRANCE) <= 1) {
 			if (isValid("LS", validMoves, numValidMoves)) {
-				registerBestPlay("LS", "liam neesonse");
+				registerRiskPlay("LS", LOOP_MESSAGE);
 				return true;
 			}
 		}
 		if (isValid("BB", validMoves, numValidMoves)) {
-			registerBestPlay("BB", "liam neesons");
+			registerRiskPlay("BB", LOOP_MESSAGE);
 			return true;
 		}
 	} 
 	if (pastLocs[numPastLocs - 1] ==BAY_OF_BISCAY) {
 		if (isValid("AO", validMoves, numValidMoves)) {
-			registerBestPlay("AO", "liam neesons");
+			registerRiskPlay("AO", LOOP_MESSAGE);
 			return true;
 		}
 	} 
@@ -578,30 +658,30 @@ bool LoopStrat(PlaceId *pastLocs, PlaceId *validMoves, int numValidMoves, int nu
 		if ((huntersInCountry(Spain, hunterLocs, SIZE_OF_SPAIN) 
 		+ huntersInCountry(France, hunterLocs, SIZE_OF_FRANCE)) > 1) {
 			if (isValid("AO", validMoves, numValidMoves)) {
-				registerBestPlay("AO", "liam neesons");
+				registerRiskPlay("AO", LOOP_MESSAGE);
 				return true;
 			}
 		}
 		if (isValid("CA", validMoves, numValidMoves)) {
-			registerBestPlay("CA", "liam neesons");
+			registerRiskPlay("CA", LOOP_MESSAGE);
 			return true;
 		}
 	} 
 	if (pastLocs[numPastLocs - 1] == CADIZ) {
 		if (huntersInCountry(Spain, hunterLocs, SIZE_OF_SPAIN) >= 1) {
 			if (isValid("AO", validMoves, numValidMoves)) {
-				registerBestPlay("AO", "liam neesons");
+				registerRiskPlay("AO", LOOP_MESSAGE);
 				return true;
 			}
 		}
 		if (isValid("GR", validMoves, numValidMoves)) {
-			registerBestPlay("GR", "liam neesons");
+			registerRiskPlay("GR", LOOP_MESSAGE);
 			return true;
 		}
 	} 
 	if (pastLocs[numPastLocs - 1] == GRANADA) {
 		if (isValid("AL", validMoves, numValidMoves)) {
-			registerBestPlay("AL", "liam neesons");
+			registerRiskPlay("AL", LOOP_MESSAGE);
 			return true;
 		}
 	} 
@@ -610,39 +690,39 @@ bool LoopStrat(PlaceId *pastLocs, PlaceId *validMoves, int numValidMoves, int nu
 			for (int player = 0; player < 4; player++) {
 				if (hunterLocs[player] == MEDITERRANEAN_SEA) {
 					if (isValid("AO", validMoves, numValidMoves)) {
-						registerBestPlay("AO", "I AM LIAM NEESONS");
+						registerRiskPlay("AO", LOOP_MESSAGE);
 						return true;
 					}
 				}
 			}
 			if (isValid("AL", validMoves, numValidMoves)) {
-				registerBestPlay("AL", "liam neesons");
+				registerRiskPlay("AL", LOOP_MESSAGE);
 				return true;
 			}
 		}
 		if (isValid("AO", validMoves, numValidMoves)) {
-			registerBestPlay("AO", "liam neesons");
+			registerRiskPlay("AO", LOOP_MESSAGE);
 			return true;
 		}
 	}
 	if (pastLocs[numPastLocs - 1] == ATLANTIC_OCEAN) {
 		if (huntersInCountry(UpperEurope, hunterLocs, SIZE_OF_UPPER_EUROPE) == 0) {
 			if (isValid("NS", validMoves, numValidMoves)) {
-				registerBestPlay("NS", "liam neesons");
+				registerRiskPlay("NS", LOOP_MESSAGE);
 				return true;
 			}
 		}
 		if (huntersInCountry(Spain, hunterLocs, SIZE_OF_SPAIN) == 0) {
 			for (int i = 0; i < numValidMoves; i++) {
 				if (isCountry(Spain, MoveToLoc(pastLocs, validMoves[i], &numPastLocs), SIZE_OF_SPAIN)) {
-					registerBestPlay(strdup(placeIdToAbbrev(validMoves[i])), "liam neesons");
+					registerRiskPlay((char *) placeIdToAbbrev(validMoves[i]), LOOP_MESSAGE);
 					return true;
 				}
 			}
 		}
 		if (huntersInCountry(Spain, hunterLocs, SIZE_OF_SPAIN) < 1) {
 			if (isValid("MS", validMoves, numValidMoves)) {
-				registerBestPlay("MS", "liam neesons");
+				registerRiskPlay("MS", LOOP_MESSAGE);
 				return true;
 			}
 		}
@@ -651,18 +731,18 @@ bool LoopStrat(PlaceId *pastLocs, PlaceId *validMoves, int numValidMoves, int nu
 		if (isValid("HA", validMoves, numValidMoves)) {
 			if (huntersInCountry(UpperEurope, hunterLocs, SIZE_OF_UPPER_EUROPE) >= 1) {
 				if (isValid("EC", validMoves, numValidMoves)) {
-					registerBestPlay("EC", "liam neesons");
+					registerRiskPlay("EC", LOOP_MESSAGE);
 					return true;
 				}
 			}
 		
-		registerBestPlay("HA", "liam neesons");
+		registerRiskPlay("HA", LOOP_MESSAGE);
 		return true;
 		}
 	}
 	if (pastLocs[numPastLocs - 1] == HAMBURG) {
 		if (isValid("BR", validMoves, numValidMoves)) {
-			registerBestPlay("BR", "liam neesons");
+			registerRiskPlay("BR", LOOP_MESSAGE);
 			return true;
 		}
 	}
@@ -678,12 +758,12 @@ bool LoopStrat(PlaceId *pastLocs, PlaceId *validMoves, int numValidMoves, int nu
 						hunterLocs[player] == NUREMBURG ||
 						hunterLocs[player] == BUDAPEST ||
 						hunterLocs[player] == KLAUSENBURG) {
-							registerBestPlay("LI", "liam neesons");
+							registerRiskPlay("LI", LOOP_MESSAGE);
 							return true;
 					}
 				}
 			}
-			registerBestPlay("PR", "liam neesons");
+			registerRiskPlay("PR", LOOP_MESSAGE);
 			return true;
 		}
 	}
@@ -691,12 +771,12 @@ bool LoopStrat(PlaceId *pastLocs, PlaceId *validMoves, int numValidMoves, int nu
 		if (huntersInCountry(England, hunterLocs, SIZE_OF_ENGLAND)
 			+ huntersInCountry(France, hunterLocs, SIZE_OF_FRANCE) <= 1) {
 			if (isValid("PL", validMoves, numValidMoves)) {
-				registerBestPlay("PL", "liam neesons");
+				registerRiskPlay("PL", LOOP_MESSAGE);
 				return true;
 			}			
 		}
 		if (isValid("AO", validMoves, numValidMoves)) {
-			registerBestPlay("AO", "liam neesons");
+			registerRiskPlay("AO", LOOP_MESSAGE);
 			return true;
 		}
 	}
@@ -705,57 +785,57 @@ bool LoopStrat(PlaceId *pastLocs, PlaceId *validMoves, int numValidMoves, int nu
 			if (huntersNearCD(hunterLocs) >= 2) {
 				return false;
 			}
-			registerBestPlay("VI", "liam neesons");
+			registerRiskPlay("VI", LOOP_MESSAGE);
 			return true;
 		}
 	}
 	if (pastLocs[numPastLocs - 1] == PLYMOUTH) {
 		if (isValid("LO", validMoves, numValidMoves)) {
-			registerBestPlay("LO", "liam neesons");
+			registerRiskPlay("LO", LOOP_MESSAGE);
 			return true;
 		}
 	}
 	if (pastLocs[numPastLocs - 1] == LONDON) {
 		if (isValid("MN", validMoves, numValidMoves)) {
-			registerBestPlay("MN", "liam neesons");
+			registerRiskPlay("MN", LOOP_MESSAGE);
 			return true;
 		}
 	}
 	if (pastLocs[numPastLocs - 1] == MANCHESTER) {
 		if (isValid("LV", validMoves, numValidMoves)) {
-			registerBestPlay("LV", "liam neesons");
+			registerRiskPlay("LV", LOOP_MESSAGE);
 			return true;
 		}
 	}
 	if (pastLocs[numPastLocs - 1] == LIVERPOOL) {
 		if (huntersInCountry(England, hunterLocs, SIZE_OF_ENGLAND) >= 1) {
 			if (isValid("IR", validMoves, numValidMoves)) {
-				registerBestPlay("IR", "liam neesons");
+				registerRiskPlay("IR", LOOP_MESSAGE);
 				return true;
 			}
 		}
 	}
 	if (pastLocs[numPastLocs - 1] == IRISH_SEA) {
 		if (isValid("DU", validMoves, numValidMoves)) {
-			registerBestPlay("DU", "liam neesons");
+			registerRiskPlay("DU", LOOP_MESSAGE);
 			return true;
 		}
 	}
 	if (pastLocs[numPastLocs - 1] == DUBLIN) {
 		if (isValid("GW", validMoves, numValidMoves)) {
-			registerBestPlay("GW", "liam neesons");
+			registerRiskPlay("GW", LOOP_MESSAGE);
 			return true;
 		}
 	}
 	if (pastLocs[numPastLocs - 1] == GALWAY) {
 		if (isValid("AO", validMoves, numValidMoves)) {
-			registerBestPlay("AO", "liam neesons");
+			registerRiskPlay("AO", LOOP_MESSAGE);
 			return true;
 		}
 	}
 	if (pastLocs[numPastLocs - 1] == MANCHESTER) {
 		if (isValid("LV", validMoves, numValidMoves)) {
-			registerBestPlay("LV", "liam neesons");
+			registerRiskPlay("LV", LOOP_MESSAGE);
 			return true;
 		}
 	}
@@ -776,32 +856,32 @@ bool LoopStrat(PlaceId *pastLocs, PlaceId *validMoves, int numValidMoves, int nu
 		}
 		if (canGoBD) {
 			if (isValid("BD", validMoves, numValidMoves)) {
-				registerBestPlay("BD", "liam neesons");
+				registerRiskPlay("BD", LOOP_MESSAGE);
 				return true;
 			}
 		}
 		if (canGoZA) {
 			if (isValid("ZA", validMoves, numValidMoves)) {
-				registerBestPlay("ZA", "liam neesons");
+				registerRiskPlay("ZA", LOOP_MESSAGE);
 				return true;
 			}
 		}
 	}
 	if (pastLocs[numPastLocs - 1] == ZAGREB) {
 		if (isValid("SJ", validMoves, numValidMoves)) {
-			registerBestPlay("SJ", "liam neesons");
+			registerRiskPlay("SJ", LOOP_MESSAGE);
 			return true;
 		}
 	}
 	if (pastLocs[numPastLocs - 1] == SARAJEVO) {
 		if (isValid("SO", validMoves, numValidMoves)) {
-			registerBestPlay("SO", "liam neesons");
+			registerRiskPlay("SO", LOOP_MESSAGE);
 			return true;
 		}
 	}
 	if (pastLocs[numPastLocs - 1] == SOFIA) {
 		if (isValid("BC", validMoves, numValidMoves)) {
-			registerBestPlay("BC", "liam neesons");
+			registerRiskPlay("BC", LOOP_MESSAGE);
 			return true;
 		}
 	}
@@ -809,7 +889,7 @@ bool LoopStrat(PlaceId *pastLocs, PlaceId *validMoves, int numValidMoves, int nu
 		for (int player = 0; player < 4; player++) {
 			if (hunterLocs[player] == KLAUSENBURG) {
 				if (isValid("ZA", validMoves, numValidMoves)) {
-					registerBestPlay("ZA", "liam neesons");
+					registerRiskPlay("ZA", LOOP_MESSAGE);
 					return true;
 				}
 			}
@@ -818,13 +898,13 @@ bool LoopStrat(PlaceId *pastLocs, PlaceId *validMoves, int numValidMoves, int nu
 			if (huntersNearCD(hunterLocs) >= 2) {
 				return false;
 			}
-			registerBestPlay("KL", "liam neesons");
+			registerRiskPlay("KL", LOOP_MESSAGE);
 			return true;
 		}
 	}	
 	if (pastLocs[numPastLocs - 1] == BUCHAREST) {
 		if (isValid("KL", validMoves, numValidMoves)) {
-			registerBestPlay("KL", "liam neesons");
+			registerRiskPlay("KL", LOOP_MESSAGE);
 			return true;
 		}
 	}
@@ -843,7 +923,7 @@ bool shouldIGoToCastleDrac(PlaceId *pastLocs, PlaceId *validMoves, int numPastLo
 			if (huntersNearCD(hunterLocs) == 1) if (visitedKlaus) return false;
 			if (visitedGalatz && visitedKlaus) return false;
 			
-			registerBestPlay(strdup(placeIdToAbbrev(validMoves[i])), "liam neesons?");
+			registerRiskPlay((char *) placeIdToAbbrev(validMoves[i]), CASTLE_MESSAGE);
 			return true;
 		} 
 	}
@@ -11,11 +11,15 @@
 
 #include <stdio.h>
 #include <string.h>
-#include <time.h>
+#include "Arena.h"
+#include "Decision.h"
 #include "Game.h"
 #include "hunter.h"
+#include "HunterMcts.h"
 #include "Map.h"
+#include "Parallel.h"
 #include "Places.h"
+#include "Random.h"
 #include "HunterView.h"
 
 #define TRUE				1
@@ -56,22 +60,57 @@ static PlaceId portReg3[] = {
 	SARAGOSSA, BARCELONA, BORDEAUX, TOULOUSE
 };
 
+// Random choices for the fixed strategies, seeded for each decision so
+// a game can be replayed
+static __thread Random rng;
+
 // Helper functions
 PlaceId doRandom(HunterView hv, Player hunter, PlaceId *places, int numLocs);
 PlaceId moveComplement(HunterView hv, Player currHunter);
 static void getHunterLocs(HunterView hv, PlaceId hunterLocs[]);
 PlaceId lowestRiskForDracula(HunterView hv, PlaceId *places, int numLocs, PlaceId hunterLocs[4], int draculaAtSea, bool considerHistory);
 int hasHuntersThere(PlaceId hunterLocs[4], PlaceId location, Player currHunter);
-bool isCountry(PlaceId country[], PlaceId location, int size);
 PlaceId neighbourCities(HunterView hv, PlaceId DraculaLoc, Player currHunter, PlaceId hunterLocs[4]);
 int isThereCDInReachable(PlaceId *places, int numLocs);
 int isPlayMinaDr(Player currHunter);
 PlaceId chooseRandCityInReg(PlaceId *reg, int maxReg);
 int atSeaSuccessive(PlaceId *history, int maxHist);
+static void decideHeuristicMove(HunterView hv);
+static void decideSearchMove(HunterView hv);
 
 void decideHunterMove(HunterView hv) {
+	// The arrays the views give back while deciding all go at the end
+	Arena arena = decisionArena();
+	Arena previous = ArenaUse(arena);
+
+	// Register the heuristic move straight away, so there's always a
+	// move even if the search is cut short
+	decideHeuristicMove(hv);
+	decideSearchMove(hv);
+
+	ArenaUse(previous);
+	ArenaReset(arena);
+}
+
+// The first round has fixed starting places; after that, search over
+// the places Dracula could be for as long as the turn allows (or for
+// the fixed number of iterations, see Decision.h)
+static void decideSearchMove(HunterView hv) {
+	if (HvGetRound(hv) == 0) return;
+
+	MctsMoveStats stats[NUM_REAL_PLACES];
+	int numMoves = HmSearchParallel(hv, decisionSeed(),
+	                                parallelNumThreads(), decisionIterations(),
+	                                stats);
+	PlaceId move = parallelBestMove(stats, numMoves);
+	if (move != NOWHERE) decisionPublish(move, "--Search--");
+}
+
+// Picks a move from the hunters' fixed strategies
+static void decideHeuristicMove(HunterView hv) {
 	Round round = HvGetRound(hv);
 	Player currHunter = HvGetPlayer(hv);
+	randomSeed(&rng, decisionSeed());
 	
 	int doneWithBestMove = FALSE;
 	if (round == 0) { 					// FIRST ROUND
@@ -100,9 +139,9 @@ void decideHunterMove(HunterView hv) {
 		if(HvGetPlayer(hv) == PLAYER_DR_SEWARD) {
 			int pathL = -1;
 			PlaceId *path = HvGetShortestPathTo(hv, PLAYER_DR_SEWARD, CASTLE_DRACULA, &pathL);
-			if(pathL == 0) registerBestPlay(strdup(placeIdToAbbrev(CASTLE_DRACULA)), "");
+			if(pathL == 0) registerBestPlay((char *) placeIdToAbbrev(CASTLE_DRACULA), "");
 			else {
-				registerBestPlay(strdup(placeIdToAbbrev(path[0])), "");
+				registerBestPlay((char *) placeIdToAbbrev(path[0]), "");
 			}
 			return;
 		}
@@ -149,7 +188,7 @@ void decideHunterMove(HunterView hv) {
 		int canGoCD = isThereCDInReachable(places, numLocs);
 
 		// ------------------Move to random loc (Safe with timing)------------------
-		registerBestPlay(strdup(placeIdToAbbrev(doRandom(hv, currHunter, places, numLocs))), "general random");
+		registerBestPlay((char *) placeIdToAbbrev(doRandom(hv, currHunter, places, numLocs)), "general random");
 
 		Round LastDracRoundSeen = -1;
 		PlaceId DraculaLoc = HvGetLastKnownDraculaLocation(hv, &LastDracRoundSeen);
@@ -173,13 +212,13 @@ void decideHunterMove(HunterView hv) {
 
 				// If we are with Dracula this round / we can arrive at where Dracula is right now in a move, definitely stay / move to encounter
 				if ((pathLength == 0 || pathLength == 1) && diff == 1) {
-					registerBestPlay(strdup(placeIdToAbbrev(DraculaLoc)), "--Encounter--");
+					registerBestPlay((char *) placeIdToAbbrev(DraculaLoc), "--Encounter--");
 					printf("Player %d meet dracula at %s %s\n", currHunter, placeIdToAbbrev(DraculaLoc), placeIdToName(DraculaLoc));
 				}
 
 				// If we can arrive where Dracula is right now in two mov e
 				else if (pathLength == 2 && diff == 1) {
-					registerBestPlay(strdup(placeIdToAbbrev(path[0])), "--Drac--");
+					registerBestPlay((char *) placeIdToAbbrev(path[0]), "--Drac--");
 				}	
 
 				// If we are get the place where Dracula was in the last round, simply go to a neighbour that's the lowest risk for dracula
@@ -190,12 +229,12 @@ void decideHunterMove(HunterView hv) {
 					if (numReturnedLocs > 0) {
 						// PlaceId lowestRisk = doRandom(hv,currHunter, notByRail, numReturnedLocs);
 						PlaceId lowestRisk = lowestRiskForDracula(hv, notByRail, numReturnedLocs, hunterLocs, draculaAtSea, false);
-						registerBestPlay(strdup(placeIdToAbbrev(lowestRisk)), "--Rail--");
+						registerBestPlay((char *) placeIdToAbbrev(lowestRisk), "--Rail--");
 					// If no such exist, then go anythere reachable
 					} else {
 						// PlaceId lowestRisk = doRandom(hv,currHunter, notByRail, numReturnedLocs);
 						PlaceId lowestRisk = lowestRiskForDracula(hv, places, numLocs, hunterLocs, draculaAtSea, false);
-						registerBestPlay(strdup(placeIdToAbbrev(lowestRisk)), "--Reachable--");
+						registerBestPlay((char *) placeIdToAbbrev(lowestRisk), "--Reachable--");
 					}
 				}
 
@@ -247,21 +286,21 @@ void decideHunterMove(HunterView hv) {
 							PlaceId *pathToNeighbouring = HvGetShortestPathTo(hv, currHunter, placeToGo, &pathLengthToNeighbouring);
 
 							if (placeIsReal(pathToNeighbouring[0])) {
-								registerBestPlay(strdup(placeIdToAbbrev(pathToNeighbouring[0])), "--neighbouring--");
+								registerBestPlay((char *) placeIdToAbbrev(pathToNeighbouring[0]), "--neighbouring--");
 							} else {
-								registerBestPlay(strdup(placeIdToAbbrev(path[0])), "--Drac--");
+								registerBestPlay((char *) placeIdToAbbrev(path[0]), "--Drac--");
 							}
 						} else {
-							registerBestPlay(strdup(placeIdToAbbrev(path[0])), "--Drac--");
+							registerBestPlay((char *) placeIdToAbbrev(path[0]), "--Drac--");
 						}
 					} else {
 						if (round % MAX_REAL_PLACE < 10) {
-							registerBestPlay(strdup(placeIdToAbbrev(currLoc)), "--Rest--");
+							registerBestPlay((char *) placeIdToAbbrev(currLoc), "--Rest--");
 						} else if(round > 3) {
 							int maxHist = -1;
 							bool canFree;
 							PlaceId *history = HvGetLocationHistory(hv, PLAYER_DRACULA, &maxHist, &canFree);
-							char *moveTo = strdup(placeIdToAbbrev(HvGetPlayerLocation(hv, HvGetPlayer(hv))));
+							char *moveTo = (char *) placeIdToAbbrev(HvGetPlayerLocation(hv, HvGetPlayer(hv)));
 							PlaceId city;
 							PlaceId *path;
 							int pathLength = -1;
@@ -275,25 +314,25 @@ void decideHunterMove(HunterView hv) {
 										city = chooseRandCityInReg(reg0, SIZE_OF_PORT0);
 										city = LIVERPOOL;
 										path = HvGetShortestPathTo(hv, currHunter, city, &pathLength);
-										if(pathLength > 0) moveTo = strdup(placeIdToAbbrev(path[0]));
+										if(pathLength > 0) moveTo = (char *) placeIdToAbbrev(path[0]);
 										break;
 									case PLAYER_DR_SEWARD:
 										city = chooseRandCityInReg(reg1, SIZE_OF_PORT1);
 										city = KLAUSENBURG;
 										path = HvGetShortestPathTo(hv, currHunter, city, &pathLength);
-										if(pathLength > 0) moveTo = strdup(placeIdToAbbrev(path[0]));
+										if(pathLength > 0) moveTo = (char *) placeIdToAbbrev(path[0]);
 										break;
 									case PLAYER_VAN_HELSING:
 										city = chooseRandCityInReg(reg2, SIZE_OF_PORT2);
 										city = AMSTERDAM;
 										path = HvGetShortestPathTo(hv, currHunter, city, &pathLength);
-										if(pathLength > 0) moveTo = strdup(placeIdToAbbrev(path[0]));
+										if(pathLength > 0) moveTo = (char *) placeIdToAbbrev(path[0]);
 										break;
 									case PLAYER_MINA_HARKER:
 										city = chooseRandCityInReg(reg3, SIZE_OF_PORT3);
 										city = CADIZ;
 										path = HvGetShortestPathTo(hv, currHunter, city, &pathLength);
-										if(pathLength > 0) moveTo = strdup(placeIdToAbbrev(path[0]));
+										if(pathLength > 0) moveTo = (char *) placeIdToAbbrev(path[0]);
 										break;
 									default:
 										break;
@@ -311,7 +350,7 @@ void decideHunterMove(HunterView hv) {
 			// If Dracula isn't there recently, do research
 			} else if (round >= 6  && round % 2 == 0) {
 				doneWithBestMove = TRUE;
-				registerBestPlay(strdup(placeIdToAbbrev(currLoc)), "Research");
+				registerBestPlay((char *) placeIdToAbbrev(currLoc), "Research");
 			}
 			return;
 		} 
@@ -319,7 +358,7 @@ void decideHunterMove(HunterView hv) {
 		// If Dracula doesn't appear at all, we rest
 		if (DraculaLoc == NOWHERE && round >= 6 && round % 2 == 0) {
 			doneWithBestMove = TRUE;
-			registerBestPlay(strdup(placeIdToAbbrev(currLoc)), "Research");
+			registerBestPlay((char *) placeIdToAbbrev(currLoc), "Research");
 			return;
 		}
 
@@ -396,7 +435,7 @@ void decideHunterMove(HunterView hv) {
 			}
 			
 			if (placeIsReal(max)) {
-				registerBestPlay(strdup(placeIdToAbbrev(max)), "--Rank--");
+				registerBestPlay((char *) placeIdToAbbrev(max), "--Rank--");
 			}
 		}
 	}
@@ -405,14 +444,13 @@ void decideHunterMove(HunterView hv) {
 
 // Return a random neigbouring city
 PlaceId doRandom(HunterView hv, Player hunter, PlaceId *places, int numLocs) {
-	srand(time(0));
 	PlaceId currLoc = HvGetPlayerLocation(hv, hunter);
 	
 	if(places == NULL) return currLoc;
 	
-	int loc = rand() % numLocs;
+	int loc = randomBelow(&rng, numLocs);
 	while (places[loc] ==  currLoc) {
-		loc = rand() % numLocs;
+		loc = randomBelow(&rng, numLocs);
 	}
 
 	return places[loc];
@@ -481,15 +519,6 @@ int hasHuntersThere(PlaceId hunterLocs[4], PlaceId location, Player currHunter)
 	return FALSE;
 }
 
-bool isCountry(PlaceId country[], PlaceId location, int size) {
-	for (int i = 0; i < size; i++) {
-		if (location == country[i]) {
-			return true;
-		}
-	}
-	return false;
-}
-
 // Return whether Castle Dracula is reachable
 int isThereCDInReachable(PlaceId *places, int numLocs) {
 	for (int i = 0; i < numLocs; i++) {
@@ -505,8 +534,7 @@ int isPlayMinaDr(Player currHunter) {
 
 // chooes a random city in an array
 PlaceId chooseRandCityInReg(PlaceId *reg, int maxReg) {
-	srand(time(0));
-	return reg[rand() % maxReg];
+	return reg[randomBelow(&rng, maxReg)];
 }
 
 // looks at the history array and returns 1 if the player was at sea 3 rounds in
@@ -0,0 +1,348 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// mkMapData.c: generates MapData.c, the read-only map of Europe
+//
+// Run at build time (see the Makefile). Reads the CONNECTIONS table in
+// Places.c and prints the map as a compressed sparse row graph: for
+// each place, MAP_EDGE_OFFSETS gives the range of MAP_EDGES holding its
+// connections. Connections are listed in the same order the old linked
+// list Map produced, so anything that iterates over them behaves the
+// same as before.
+//
+// It also precomputes, as PlaceSets, the places one road or boat trip
+// away from each place, and the places within 0-3 rail hops of it, and
+// the shortest paths between every pair of places for a hunter (which
+// depend on how far they can go by rail on their first move).
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Bfs.h"
+#include "Map.h"
+#include "PlaceSet.h"
+#include "Places.h"
+
+// More than enough for the real map (which has ~400 directed edges)
+#define MAX_EDGES_PER_PLACE 32
+
+typedef struct edge {
+	PlaceId       p;
+	TransportType type;
+} Edge;
+
+static Edge edges[NUM_REAL_PLACES][MAX_EDGES_PER_PLACE];
+static int  numEdges[NUM_REAL_PLACES];
+static int  numConnections;
+
+static void addConnection(PlaceId v, PlaceId w, TransportType type);
+static bool hasEdge(PlaceId v, PlaceId w, TransportType type);
+static void addEdge(PlaceId v, PlaceId w, TransportType type);
+static const char *transportTypeName(TransportType type);
+
+static void printHeader(void);
+static void printOffsets(void);
+static void printEdges(void);
+static void printConnNodes(void);
+static void printSets(void);
+static PlaceSet neighbours(PlaceId v, TransportType type);
+static PlaceSet railReachable(PlaceId v, int maxHops);
+static PlaceSet railNeighbours(PlaceId v, int depth, void *arg);
+static void printSet(PlaceSet s, PlaceId v);
+static void printHunterPaths(void);
+static PlaceSet hunterReachable(PlaceId v, int railPhase);
+static PlaceSet hunterNeighbours(PlaceId v, int depth, void *arg);
+static void hunterBfs(PlaceId src, int railPhase,
+                      int dist[NUM_REAL_PLACES], PlaceId pred[NUM_REAL_PLACES]);
+
+////////////////////////////////////////////////////////////////////////
+
+int main(void)
+{
+	for (int i = 0; CONNECTIONS[i].t != ANY; i++) {
+		addConnection(CONNECTIONS[i].v, CONNECTIONS[i].w, CONNECTIONS[i].t);
+	}
+	
+	printHeader();
+	printOffsets();
+	printEdges();
+	printConnNodes();
+	printSets();
+	printHunterPaths();
+	return EXIT_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////
+
+/// Add an undirected connection, ignoring duplicates
+static void addConnection(PlaceId v, PlaceId w, TransportType type)
+{
+	assert(v != w);
+	assert(placeIsReal(v) && placeIsReal(w));
+	assert(transportTypeIsValid(type));
+	
+	if (hasEdge(v, w, type)) return;
+	addEdge(v, w, type);
+	addEdge(w, v, type);
+	numConnections++;
+}
+
+static bool hasEdge(PlaceId v, PlaceId w, TransportType type)
+{
+	for (int i = 0; i < numEdges[v]; i++) {
+		if (edges[v][i].p == w && edges[v][i].type == type) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static void addEdge(PlaceId v, PlaceId w, TransportType type)
+{
+	assert(numEdges[v] < MAX_EDGES_PER_PLACE);
+	edges[v][numEdges[v]++] = (Edge) { w, type };
+}
+
+/**
+ * Gets the i'th edge out of place v, in the order the old Map listed
+ * them (it inserted at the front of each list, so newest first)
+ */
+static Edge getEdge(PlaceId v, int i)
+{
+	return edges[v][numEdges[v] - 1 - i];
+}
+
+static const char *transportTypeName(TransportType type)
+{
+	switch (type) {
+		case ROAD: return "ROAD";
+		case RAIL: return "RAIL";
+		case BOAT: return "BOAT";
+		default:   assert(0); return NULL;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+
+static void printHeader(void)
+{
+	int total = 0;
+	for (int v = 0; v < NUM_REAL_PLACES; v++) total += numEdges[v];
+	
+	printf("// MapData.c: generated by mkMapData from Places.c.\n");
+	printf("// Do not edit - run `make` to regenerate.\n\n");
+	printf("#include <stddef.h>\n");
+	printf("#include <stdint.h>\n\n");
+	printf("#include \"Map.h\"\n");
+	printf("#include \"MapData.h\"\n");
+	printf("#include \"PlaceSet.h\"\n");
+	printf("#include \"Places.h\"\n\n");
+	printf("const int MAP_NUM_CONNECTIONS = %d;\n\n", numConnections);
+	printf("const int MAP_NUM_EDGES = %d;\n\n", total);
+}
+
+static void printOffsets(void)
+{
+	printf("const int MAP_EDGE_OFFSETS[NUM_REAL_PLACES + 1] = {\n");
+	int offset = 0;
+	for (int v = 0; v < NUM_REAL_PLACES; v++) {
+		printf("\t%4d, // %s\n", offset, placeIdToAbbrev(v));
+		offset += numEdges[v];
+	}
+	printf("\t%4d,\n};\n\n", offset);
+}
+
+static void printEdges(void)
+{
+	printf("const MapEdge MAP_EDGES[] = {\n");
+	for (int v = 0; v < NUM_REAL_PLACES; v++) {
+		printf("\t// %s\n", placeIdToAbbrev(v));
+		for (int i = 0; i < numEdges[v]; i++) {
+			Edge e = getEdge(v, i);
+			printf("\t{ %2d, %s }, // %s\n", e.p, transportTypeName(e.type),
+			       placeIdToAbbrev(e.p));
+		}
+	}
+	printf("};\n\n");
+}
+
+/**
+ * The same edges again as connNodes, linked to each other in place, so
+ * MapGetConnections can keep handing out ConnLists without allocating
+ */
+static void printConnNodes(void)
+{
+	printf("const struct connNode MAP_CONN_NODES[] = {\n");
+	int index = 0;
+	for (int v = 0; v < NUM_REAL_PLACES; v++) {
+		printf("\t// %s\n", placeIdToAbbrev(v));
+		for (int i = 0; i < numEdges[v]; i++, index++) {
+			Edge e = getEdge(v, i);
+			if (i == numEdges[v] - 1) {
+				printf("\t{ %2d, %s, NULL },\n", e.p,
+				       transportTypeName(e.type));
+			} else {
+				printf("\t{ %2d, %s, &MAP_CONN_NODES[%d] },\n", e.p,
+				       transportTypeName(e.type), index + 1);
+			}
+		}
+	}
+	printf("};\n");
+}
+
+////////////////////////////////////////////////////////////////////////
+
+static void printSets(void)
+{
+	printf("\nconst PlaceSet MAP_ROAD_SETS[NUM_REAL_PLACES] = {\n");
+	for (int v = 0; v < NUM_REAL_PLACES; v++) {
+		printSet(neighbours(v, ROAD), v);
+	}
+	printf("};\n\n");
+	
+	printf("const PlaceSet MAP_BOAT_SETS[NUM_REAL_PLACES] = {\n");
+	for (int v = 0; v < NUM_REAL_PLACES; v++) {
+		printSet(neighbours(v, BOAT), v);
+	}
+	printf("};\n\n");
+	
+	PlaceSet land = PLACE_SET_EMPTY;
+	PlaceSet sea = PLACE_SET_EMPTY;
+	for (int v = 0; v < NUM_REAL_PLACES; v++) {
+		placeSetAdd(placeIsSea(v) ? &sea : &land, v);
+	}
+	printf("const PlaceSet MAP_LAND_SET =\n");
+	printSet(land, NOWHERE);
+	printf("const PlaceSet MAP_SEA_SET =\n");
+	printSet(sea, NOWHERE);
+	printf("\n");
+	
+	printf("const PlaceSet MAP_RAIL_SETS[%d][NUM_REAL_PLACES] = {\n",
+	       MAP_MAX_RAIL_HOPS + 1);
+	for (int hops = 0; hops <= MAP_MAX_RAIL_HOPS; hops++) {
+		printf("\t{ // %d hop%s\n", hops, hops == 1 ? "" : "s");
+		for (int v = 0; v < NUM_REAL_PLACES; v++) {
+			printf("\t");
+			printSet(railReachable(v, hops), v);
+		}
+		printf("\t},\n");
+	}
+	printf("};\n");
+}
+
+static PlaceSet neighbours(PlaceId v, TransportType type)
+{
+	PlaceSet s = PLACE_SET_EMPTY;
+	for (int i = 0; i < numEdges[v]; i++) {
+		if (edges[v][i].type == type) {
+			placeSetAdd(&s, edges[v][i].p);
+		}
+	}
+	return s;
+}
+
+/// Places within maxHops rail hops of v, including v itself
+static PlaceSet railReachable(PlaceId v, int maxHops)
+{
+	return bfsWithin(v, maxHops, railNeighbours, NULL);
+}
+
+static PlaceSet railNeighbours(PlaceId v, int depth, void *arg)
+{
+	return neighbours(v, RAIL);
+}
+
+/// Prints a set initialiser, labelled with v if it's a real place
+static void printSet(PlaceSet s, PlaceId v)
+{
+	printf("\t{{ UINT64_C(0x%016llx), UINT64_C(0x%016llx) }}",
+	       (unsigned long long) s.bits[0], (unsigned long long) s.bits[1]);
+	if (placeIsReal(v)) {
+		printf(", // %s\n", placeIdToAbbrev(v));
+	} else {
+		printf(";\n");
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+
+static void printHunterPaths(void)
+{
+	static int dist[MAP_NUM_RAIL_PHASES][NUM_REAL_PLACES][NUM_REAL_PLACES];
+	static PlaceId pred[MAP_NUM_RAIL_PHASES][NUM_REAL_PLACES][NUM_REAL_PLACES];
+	for (int phase = 0; phase < MAP_NUM_RAIL_PHASES; phase++) {
+		for (int src = 0; src < NUM_REAL_PLACES; src++) {
+			hunterBfs(src, phase, dist[phase][src], pred[phase][src]);
+		}
+	}
+	
+	printf("\nconst unsigned char MAP_HUNTER_DIST[MAP_NUM_RAIL_PHASES]"
+	       "[NUM_REAL_PLACES][NUM_REAL_PLACES] = {\n");
+	for (int phase = 0; phase < MAP_NUM_RAIL_PHASES; phase++) {
+		printf("\t{ // rail phase %d\n", phase);
+		for (int src = 0; src < NUM_REAL_PLACES; src++) {
+			printf("\t\t{");
+			for (int dest = 0; dest < NUM_REAL_PLACES; dest++) {
+				printf("%s%d", dest == 0 ? " " : ",", dist[phase][src][dest]);
+			}
+			printf(" }, // %s\n", placeIdToAbbrev(src));
+		}
+		printf("\t},\n");
+	}
+	printf("};\n\n");
+	
+	printf("const unsigned char MAP_HUNTER_PRED[MAP_NUM_RAIL_PHASES]"
+	       "[NUM_REAL_PLACES][NUM_REAL_PLACES] = {\n");
+	for (int phase = 0; phase < MAP_NUM_RAIL_PHASES; phase++) {
+		printf("\t{ // rail phase %d\n", phase);
+		for (int src = 0; src < NUM_REAL_PLACES; src++) {
+			printf("\t\t{");
+			for (int dest = 0; dest < NUM_REAL_PLACES; dest++) {
+				printf("%s%d", dest == 0 ? " " : ",", pred[phase][src][dest]);
+			}
+			printf(" }, // %s\n", placeIdToAbbrev(src));
+		}
+		printf("\t},\n");
+	}
+	printf("};\n");
+}
+
+/// Places a hunter can reach in one move, including v itself
+static PlaceSet hunterReachable(PlaceId v, int railPhase)
+{
+	PlaceSet s = placeSetOf(v);
+	s = placeSetUnion(s, neighbours(v, ROAD));
+	s = placeSetUnion(s, railReachable(v, railPhase));
+	s = placeSetUnion(s, neighbours(v, BOAT));
+	return s;
+}
+
+/// Places a hunter can reach in one move from v, `depth` moves after
+/// the one where they can go *(int *) arg rail hops
+static PlaceSet hunterNeighbours(PlaceId v, int depth, void *arg)
+{
+	int railPhase = *(int *) arg;
+	return hunterReachable(v, (railPhase + depth) % MAP_NUM_RAIL_PHASES);
+}
+
+/**
+ * A breadth-first search over a hunter's moves, one layer per round.
+ * Places are expanded in queue order and each one's neighbours are
+ * visited in increasing order, so ties are broken the same way the
+ * HunterView search used to break them.
+ */
+static void hunterBfs(PlaceId src, int railPhase,
+                      int dist[NUM_REAL_PLACES], PlaceId pred[NUM_REAL_PLACES])
+{
+	int numReached = bfsSearch(src, BFS_NO_LIMIT, hunterNeighbours,
+	                           &railPhase, dist, pred);
+	
+	// Every place is reachable by a hunter
+	assert(numReached == NUM_REAL_PLACES);
+	for (int i = 0; i < NUM_REAL_PLACES; i++) {
+		assert(dist[i] >= 0);
+	}
+}
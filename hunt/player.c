@@ -20,6 +20,11 @@
 // decideMove function if it goes into an infinite loop. Sort  that  out
 // before you submit.
 //
+// Run with --serve, it stays up and makes one decision per line of
+// stdin instead (see serve below), so the views and tables it builds
+// are kept from one turn to the next. Run with --batch FILE, it makes a
+// decision for every line of FILE, several at a time (see batch below).
+//
 // Based on the program by David Collien, written in 2012
 //
 // 2017-12-04	v1.1	Team Dracula <cs2521@cse.unsw.edu.au>
@@ -28,11 +33,17 @@
 //
 ////////////////////////////////////////////////////////////////////////
 
+#include <pthread.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <unistd.h>
 
+#include "Decision.h"
 #include "Game.h"
+#include "Parallel.h"
 #ifdef I_AM_DRACULA
 # include "dracula.h"
 # include "DraculaView.h"
@@ -44,19 +55,24 @@
 // Moves given by registerBestPlay are this long (including terminator)
 #define MOVE_SIZE 3
 
-// The minimum static globals I can get away with
-static char latestPlay[MOVE_SIZE] = "";
-static char latestMessage[MESSAGE_SIZE] = "";
+// Each play is 7 characters, and plays are separated by spaces
+#define PLAY_SIZE 8
+
+// The minimum static globals I can get away with (one per thread, for
+// --batch)
+static __thread char latestPlay[MOVE_SIZE] = "";
+static __thread char latestMessage[MESSAGE_SIZE] = "";
 
 // A pseudo-generic interface, which defines
 // - a type `View',
-// - functions `ViewNew', `decideMove', `ViewFree',
+// - functions `ViewNew', `ViewApplyPlay', `decideMove', `ViewFree',
 // - a trail `xtrail', and a message buffer `xmsgs'.
 #ifdef I_AM_DRACULA
 
 typedef DraculaView View;
 
 # define ViewNew DvNew
+# define ViewApplyPlay DvApplyPlay
 # define decideMove decideDraculaMove
 # define ViewFree DvFree
 
@@ -68,6 +84,7 @@ typedef DraculaView View;
 typedef HunterView View;
 
 # define ViewNew HvNew
+# define ViewApplyPlay HvApplyPlay
 # define decideMove decideHunterMove
 # define ViewFree HvFree
 
@@ -78,8 +95,39 @@ typedef HunterView View;
 
 #endif
 
-int main(void)
+// One line of a --batch file, and the decision made for it
+typedef struct batchItem {
+	char   *line;
+	char    move[MOVE_SIZE];
+	Message message;
+	double  msecs;
+} BatchItem;
+
+typedef struct batch {
+	BatchItem   *items;
+	int          numItems;
+	int          nextItem;  // the next one to be taken by a worker
+	unsigned int seed;
+} Batch;
+
+static void serve(void);
+static void batch(const char *filename);
+static void *runBatchWorker(void *arg);
+static FILE *takeStdout(void);
+static Message *splitMessages(char *line);
+static bool extendsPlays(const char *pastPlays, const char *previous);
+
+int main(int argc, char *argv[])
 {
+	if (argc > 1 && strcmp(argv[1], "--serve") == 0) {
+		serve();
+		return EXIT_SUCCESS;
+	}
+	if (argc > 2 && strcmp(argv[1], "--batch") == 0) {
+		batch(argv[2]);
+		return EXIT_SUCCESS;
+	}
+
 	char *pastPlays = xPastPlays;
 	Message msgs[] = xMsgs;
 
@@ -91,6 +139,179 @@ int main(void)
 	return EXIT_SUCCESS;
 }
 
+// Makes one decision per line of stdin, until it runs out. Each line
+// is the pastPlays string, then each play's message, all separated by
+// tabs; each answer is the move and message, separated by a tab. When
+// a line carries on from the one before (as it does over a game), the
+// view is kept and only the new plays are applied to it.
+static void serve(void)
+{
+	FILE *answers = takeStdout();
+	View state = NULL;
+	char *previous = NULL;
+	char *line = NULL;
+	size_t lineSize = 0;
+	while (getline(&line, &lineSize, stdin) != -1) {
+		decisionBegin();
+		line[strcspn(line, "\n")] = '\0';
+		Message *msgs = splitMessages(line);
+
+		if (state != NULL && extendsPlays(line, previous)) {
+			size_t start = strlen(previous);
+			if (line[start] == ' ') start++;
+			for (size_t i = start; i < strlen(line); i += PLAY_SIZE) {
+				ViewApplyPlay(state, &line[i]);
+			}
+		} else {
+			if (state != NULL) ViewFree(state);
+			state = ViewNew(line, msgs);
+		}
+		free(previous);
+		previous = strdup(line);
+		free(msgs);
+
+		latestPlay[0] = '\0';
+		latestMessage[0] = '\0';
+		decideMove(state);
+		fprintf(answers, "%s\t%s\n", latestPlay, latestMessage);
+		fflush(answers);
+	}
+
+	if (state != NULL) ViewFree(state);
+	free(previous);
+	free(line);
+	fclose(answers);
+}
+
+// Makes a decision for every line of the file ("-" for stdin), each
+// from scratch, on as many threads as a search would use (FOD_THREADS).
+// Each line is a request, as for serve; each answer is the move, the
+// message and how long the decision took in milliseconds, separated by
+// tabs, in the same order as the requests. Each decision's search
+// stays on its own thread, and is seeded from FOD_SEED and the line
+// number, so a batch gives the same answers however it's spread out
+// (as far as the clock allows).
+static void batch(const char *filename)
+{
+	FILE *in = (strcmp(filename, "-") == 0) ? stdin : fopen(filename, "r");
+	if (in == NULL) {
+		fprintf(stderr, "Couldn't open %s\n", filename);
+		exit(EXIT_FAILURE);
+	}
+
+	Batch b = { .items = NULL, .numItems = 0, .nextItem = 0,
+	            .seed = decisionSeed() };
+	int capacity = 0;
+	char *line = NULL;
+	size_t lineSize = 0;
+	while (getline(&line, &lineSize, in) != -1) {
+		if (b.numItems == capacity) {
+			capacity = (capacity == 0) ? 64 : capacity * 2;
+			b.items = realloc(b.items, capacity * sizeof(BatchItem));
+			if (b.items == NULL) {
+				fprintf(stderr, "Couldn't allocate batch\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+		line[strcspn(line, "\n")] = '\0';
+		b.items[b.numItems++] = (BatchItem) { .line = strdup(line) };
+	}
+	free(line);
+	if (in != stdin) fclose(in);
+
+	FILE *answers = takeStdout();
+	int numWorkers = parallelNumThreads();
+	parallelSetThreads(1);
+	pthread_t workers[MAX_THREADS];
+	bool started[MAX_THREADS];
+	for (int i = 1; i < numWorkers; i++) {
+		started[i] = pthread_create(&workers[i], NULL,
+		                            runBatchWorker, &b) == 0;
+	}
+	runBatchWorker(&b);
+	for (int i = 1; i < numWorkers; i++) {
+		if (started[i]) pthread_join(workers[i], NULL);
+	}
+
+	for (int i = 0; i < b.numItems; i++) {
+		fprintf(answers, "%s\t%s\t%.3f\n", b.items[i].move,
+		        b.items[i].message, b.items[i].msecs);
+		free(b.items[i].line);
+	}
+	free(b.items);
+	fclose(answers);
+}
+
+// Makes decisions for batch items until there are none left
+static void *runBatchWorker(void *arg)
+{
+	Batch *b = arg;
+	decisionUseThreadState(b->seed);
+	while (true) {
+		int i = __atomic_fetch_add(&b->nextItem, 1, __ATOMIC_RELAXED);
+		if (i >= b->numItems) break;
+		BatchItem *item = &b->items[i];
+
+		struct timespec start, end;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		decisionSetSeed(b->seed + i);
+		decisionBegin();
+		Message *msgs = splitMessages(item->line);
+		View state = ViewNew(item->line, msgs);
+		latestPlay[0] = '\0';
+		latestMessage[0] = '\0';
+		decideMove(state);
+		ViewFree(state);
+		free(msgs);
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		strcpy(item->move, latestPlay);
+		strcpy(item->message, latestMessage);
+		item->msecs = (end.tv_sec - start.tv_sec) * 1000.0
+		            + (end.tv_nsec - start.tv_nsec) / 1000000.0;
+	}
+	return NULL;
+}
+
+// Gets a stream for the answers, and sends anything else the AI prints
+// to stderr, so it can't get mixed up with them
+static FILE *takeStdout(void)
+{
+	FILE *answers = fdopen(dup(STDOUT_FILENO), "w");
+	dup2(STDERR_FILENO, STDOUT_FILENO);
+	return answers;
+}
+
+// Cuts the messages off the end of a request line, and returns them
+static Message *splitMessages(char *line)
+{
+	int numPlays = (strlen(line) + 1) / PLAY_SIZE;
+	Message *msgs = calloc(numPlays + 1, sizeof(Message));
+	if (msgs == NULL) {
+		fprintf(stderr, "Couldn't allocate messages\n");
+		exit(EXIT_FAILURE);
+	}
+
+	char *tab = strchr(line, '\t');
+	if (tab != NULL) *tab = '\0';
+	for (int i = 0; tab != NULL && i < numPlays; i++) {
+		char *msg = tab + 1;
+		tab = strchr(msg, '\t');
+		if (tab != NULL) *tab = '\0';
+		strncpy(msgs[i], msg, MESSAGE_SIZE - 1);
+	}
+	return msgs;
+}
+
+// Whether pastPlays is previous with zero or more plays added
+static bool extendsPlays(const char *pastPlays, const char *previous)
+{
+	size_t length = strlen(previous);
+	return strncmp(pastPlays, previous, length) == 0
+	    && (length == 0 || pastPlays[length] == '\0'
+	                    || pastPlays[length] == ' ');
+}
+
 // Saves characters from play (and appends a terminator)
 // and saves characters from message (and appends a terminator)
 void registerBestPlay(char *play, Message message)
@@ -0,0 +1,366 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// referee.c: play a whole game between our hunter and Dracula AIs
+//
+// Runs both AIs one turn at a time, the way the real game engine does:
+// Dracula sees every play, while the hunters see his moves as C? or S?
+// until something gives them away. Each move is checked against the
+// rules and turned into a full play by GameView, which also keeps the
+// score.
+//
+// The AIs are the ones linked into this program, unless -d or -h names
+// a player to run instead. That player is started once with --serve,
+// and asked for each move in turn, so it can be a different build.
+//
+// Usage: ./referee [-t msecs] [-s seed] [-i iterations] [-d dracula]
+//                  [-h hunter] [-v]
+//     -t msecs    the time allowed per turn (default 10)
+//     -s seed     the random seed for both AIs' searches
+//     -i n        run each search thread for n iterations, however long
+//                 that takes, instead of stopping at the deadline
+//     -d dracula  a Dracula player to run (e.g. ./dracula)
+//     -h hunter   a hunter player to run, for all four hunters
+//     -v          print each play as it's made
+//
+// It ends by printing the final score and round, in the same format
+// as the real game engine, so results.sh can read it. With -s and -i
+// (and the same FOD_THREADS), a game plays out the same way each time.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Decision.h"
+#include "dracula.h"
+#include "DraculaView.h"
+#include "Game.h"
+#include "GameView.h"
+#include "Generate.h"
+#include "hunter.h"
+#include "HunterView.h"
+#include "Places.h"
+
+#define DEFAULT_TURN_MSECS 10
+
+// Each play is 7 characters, and plays are separated by spaces
+#define PLAY_LENGTH        7
+#define PLAY_SIZE          (PLAY_LENGTH + 1)
+
+// The score drops every round, so the game can't go on longer than this
+#define MAX_ROUNDS         (GAME_START_SCORE + 1)
+#define MAX_PLAYS          (MAX_ROUNDS * NUM_PLAYERS)
+
+// Moves given by registerBestPlay are this long (including terminator)
+#define MOVE_SIZE          3
+
+// A player running with --serve, in another process
+typedef struct server {
+	pid_t pid;
+	FILE *requests;  // its stdin
+	FILE *replies;   // its stdout
+} Server;
+
+typedef struct game {
+	GameView gv;                                  // the full game
+	int      numPlays;
+	char     pastPlays[MAX_PLAYS * PLAY_SIZE];    // as Dracula sees it
+	char     hunterPlays[MAX_PLAYS * PLAY_SIZE];  // as the hunters see it
+	Message  messages[MAX_PLAYS];
+	Server  *dracula;                             // NULL to use ours
+	Server  *hunters;                             // NULL to use ours
+} Game;
+
+static char latestPlay[MOVE_SIZE] = "";
+static char latestMessage[MESSAGE_SIZE] = "";
+
+static PlaceId askDracula(Game *game);
+static PlaceId askHunter(Game *game, Player hunter);
+static PlaceId latestMove(void);
+static Server *startServer(const char *program);
+static void askServer(Server *server, char *pastPlays, Message messages[],
+                      int numPlays);
+static void stopServer(Server *server);
+static void makePlay(Game *game, PlaceId move, bool verbose);
+static bool gameOver(Game *game);
+
+int main(int argc, char *argv[])
+{
+	int turnMsecs = DEFAULT_TURN_MSECS;
+	bool verbose = false;
+	const char *draculaProgram = NULL;
+	const char *hunterProgram = NULL;
+	int opt;
+	while ((opt = getopt(argc, argv, "t:s:i:d:h:v")) != -1) {
+		switch (opt) {
+			case 't': turnMsecs = atoi(optarg);                     break;
+			case 's':
+				decisionSetSeed(strtoul(optarg, NULL, 10));
+				setenv("FOD_SEED", optarg, 1);
+				break;
+			case 'i':
+				decisionSetIterations(atoi(optarg));
+				setenv("FOD_ITERATIONS", optarg, 1);
+				break;
+			case 'd': draculaProgram = optarg;                      break;
+			case 'h': hunterProgram = optarg;                       break;
+			case 'v': verbose = true;                               break;
+			default:
+				fprintf(stderr, "usage: %s [-t msecs] [-s seed] "
+				        "[-i iterations] [-d dracula] [-h hunter] [-v]\n",
+				        argv[0]);
+				exit(EXIT_FAILURE);
+		}
+	}
+	decisionSetBudget(turnMsecs, 0);
+
+	Game *game = calloc(1, sizeof(*game));
+	if (game == NULL) {
+		fprintf(stderr, "Couldn't allocate Game\n");
+		exit(EXIT_FAILURE);
+	}
+	game->gv = GvNew("", NULL);
+
+	// Players run with --serve get the same turn budget as ours
+	char budget[16];
+	snprintf(budget, sizeof(budget), "%d", turnMsecs);
+	setenv("FOD_TURN_MSECS", budget, 1);
+	setenv("FOD_MARGIN_MSECS", "0", 1);
+	if (draculaProgram != NULL) game->dracula = startServer(draculaProgram);
+	if (hunterProgram != NULL) game->hunters = startServer(hunterProgram);
+
+	while (!gameOver(game)) {
+		Player player = GvGetPlayer(game->gv);
+		PlaceId move = (player == PLAYER_DRACULA)
+		             ? askDracula(game)
+		             : askHunter(game, player);
+		makePlay(game, move, verbose);
+	}
+
+	printf("> End of game:\n");
+	printf("  score: %d\n", GvGetScore(game->gv));
+	printf("  health: %d\n", GvGetHealth(game->gv, PLAYER_DRACULA));
+	printf("  revealedPastPlays: %s\n", game->pastPlays);
+	printf("Final score: %d\n", GvGetScore(game->gv));
+	printf("Final round: %d\n", GvGetRound(game->gv));
+
+	if (game->dracula != NULL) stopServer(game->dracula);
+	if (game->hunters != NULL) stopServer(game->hunters);
+	GvFree(game->gv);
+	free(game);
+	return EXIT_SUCCESS;
+}
+
+// Stands in for the one in player.c
+void registerBestPlay(char *play, Message message)
+{
+	strncpy(latestPlay, play, MOVE_SIZE - 1);
+	latestPlay[MOVE_SIZE - 1] = '\0';
+	strncpy(latestMessage, message, MESSAGE_SIZE - 1);
+	latestMessage[MESSAGE_SIZE - 1] = '\0';
+}
+
+////////////////////////////////////////////////////////////////////////
+// Asking the AIs for moves
+
+/**
+ * Gets Dracula's move, from his view of the game. If it isn't one of
+ * his valid moves, he makes the first valid one instead.
+ */
+static PlaceId askDracula(Game *game) {
+	DraculaView dv = DvNew(game->pastPlays, game->messages);
+	latestPlay[0] = '\0';
+	if (game->dracula != NULL) {
+		askServer(game->dracula, game->pastPlays, game->messages,
+		          game->numPlays);
+	} else {
+		decisionBegin();
+		decideDraculaMove(dv);
+	}
+	PlaceId move = latestMove();
+
+	PlaceId moves[NUM_REAL_PLACES];
+	int numMoves = DvFillValidMoves(dv, moves);
+	bool valid = false;
+	if (DvGetRound(dv) == 0) {
+		valid = placeIsReal(move) && move != ST_JOSEPH_AND_ST_MARY;
+	} else if (numMoves == 0) {
+		// He's boxed in, so he teleports whatever he says
+		valid = true;
+		move = TELEPORT;
+	} else {
+		for (int i = 0; i < numMoves && !valid; i++) {
+			valid = moves[i] == move;
+		}
+	}
+
+	if (!valid) {
+		fprintf(stderr, "Dracula made an invalid move '%s'\n", latestPlay);
+		move = (numMoves > 0) ? moves[0] : CASTLE_DRACULA;
+	}
+	DvFree(dv);
+	return move;
+}
+
+/**
+ * Gets a hunter's move, from the hunters' view of the game. If it isn't
+ * somewhere they can go, they stay where they are instead.
+ */
+static PlaceId askHunter(Game *game, Player hunter) {
+	generateHunterPlays(game->gv, game->pastPlays, game->hunterPlays);
+	HunterView hv = HvNew(game->hunterPlays, game->messages);
+	latestPlay[0] = '\0';
+	if (game->hunters != NULL) {
+		askServer(game->hunters, game->hunterPlays, game->messages,
+		          game->numPlays);
+	} else {
+		decisionBegin();
+		decideHunterMove(hv);
+	}
+	PlaceId move = latestMove();
+
+	bool valid = false;
+	PlaceId from = HvGetPlayerLocation(hv, hunter);
+	if (HvGetRound(hv) == 0) {
+		valid = placeIsReal(move);
+	} else {
+		int numMoves = 0;
+		PlaceId *moves = HvWhereCanIGo(hv, &numMoves);
+		for (int i = 0; i < numMoves && !valid; i++) {
+			valid = moves[i] == move;
+		}
+		free(moves);
+	}
+
+	if (!valid) {
+		fprintf(stderr, "Hunter %d made an invalid move '%s'\n",
+		        hunter, latestPlay);
+		move = placeIsReal(from) ? from : ST_JOSEPH_AND_ST_MARY;
+	}
+	HvFree(hv);
+	return move;
+}
+
+static PlaceId latestMove(void) {
+	return (latestPlay[0] == '\0') ? NOWHERE : placeAbbrevToId(latestPlay);
+}
+
+////////////////////////////////////////////////////////////////////////
+// Players in other processes
+
+/**
+ * Starts `program --serve`, with pipes to its stdin and stdout
+ */
+static Server *startServer(const char *program) {
+	int toServer[2];
+	int fromServer[2];
+	if (pipe(toServer) != 0 || pipe(fromServer) != 0) {
+		fprintf(stderr, "Couldn't create pipes for %s\n", program);
+		exit(EXIT_FAILURE);
+	}
+
+	pid_t pid = fork();
+	if (pid < 0) {
+		fprintf(stderr, "Couldn't start %s\n", program);
+		exit(EXIT_FAILURE);
+	}
+	if (pid == 0) {
+		dup2(toServer[0], STDIN_FILENO);
+		dup2(fromServer[1], STDOUT_FILENO);
+		close(toServer[0]);
+		close(toServer[1]);
+		close(fromServer[0]);
+		close(fromServer[1]);
+		execl(program, program, "--serve", (char *) NULL);
+		fprintf(stderr, "Couldn't run %s\n", program);
+		_exit(EXIT_FAILURE);
+	}
+
+	// Players started later mustn't hold this one's pipes open, or it
+	// won't see the end of its input when it's stopped
+	close(toServer[0]);
+	close(fromServer[1]);
+	fcntl(toServer[1], F_SETFD, FD_CLOEXEC);
+	fcntl(fromServer[0], F_SETFD, FD_CLOEXEC);
+	Server *server = malloc(sizeof(*server));
+	if (server == NULL) {
+		fprintf(stderr, "Couldn't allocate Server\n");
+		exit(EXIT_FAILURE);
+	}
+	server->pid = pid;
+	server->requests = fdopen(toServer[1], "w");
+	server->replies = fdopen(fromServer[0], "r");
+	return server;
+}
+
+/**
+ * Sends the plays and messages so far, as one line, and registers the
+ * move and message that come back
+ */
+static void askServer(Server *server, char *pastPlays, Message messages[],
+                      int numPlays) {
+	fputs(pastPlays, server->requests);
+	for (int i = 0; i < numPlays; i++) {
+		fputc('\t', server->requests);
+		for (char *c = messages[i]; *c != '\0'; c++) {
+			fputc((*c == '\t' || *c == '\n') ? ' ' : *c, server->requests);
+		}
+	}
+	fputc('\n', server->requests);
+	fflush(server->requests);
+
+	char reply[MOVE_SIZE + MESSAGE_SIZE + 2];
+	if (fgets(reply, sizeof(reply), server->replies) == NULL) {
+		fprintf(stderr, "A player stopped answering\n");
+		exit(EXIT_FAILURE);
+	}
+	reply[strcspn(reply, "\n")] = '\0';
+	char *message = strchr(reply, '\t');
+	if (message != NULL) *message++ = '\0';
+	registerBestPlay(reply, (message != NULL) ? message : "");
+}
+
+static void stopServer(Server *server) {
+	fclose(server->requests);
+	fclose(server->replies);
+	waitpid(server->pid, NULL, 0);
+	free(server);
+}
+
+/**
+ * Makes the current player's move, with the encounters and so on that
+ * go with it, and adds it to the history
+ */
+static void makePlay(Game *game, PlaceId move, bool verbose) {
+	char play[PLAY_SIZE];
+	GvBuildPlay(game->gv, move, play);
+
+	char *end = &game->pastPlays[game->numPlays * PLAY_SIZE];
+	if (game->numPlays > 0) {
+		end[-1] = ' ';
+	}
+	memcpy(end, play, PLAY_LENGTH);
+	end[PLAY_LENGTH] = '\0';
+
+	if (verbose) {
+		printf("> Round %d: %s  %s\n", GvGetRound(game->gv),
+		       play, latestMessage);
+	}
+
+	strcpy(game->messages[game->numPlays], latestMessage);
+	game->numPlays++;
+	GvApplyPlay(game->gv, play);
+}
+
+static bool gameOver(Game *game) {
+	return GvGetScore(game->gv) <= 0
+	    || GvGetHealth(game->gv, PLAYER_DRACULA) <= 0
+	    || game->numPlays >= MAX_PLAYS;
+}
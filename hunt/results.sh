@@ -1,7 +1,29 @@
 #!/bin/sh
+# ./results.sh        play games with the course's dry-run engine
+# ./results.sh local  play them in-process with ./referee (make referee)
+
+# everything the AIs are built from, apart from what the engine supplies
+FILES="hunter.c dracula.c HunterView.c HunterView.h GameView.c GameView.h
+    DraculaView.c DraculaView.h Map.c Map.h utils.c utils.h
+    MapData.h mkMapData.c
+    PlaceSet.h
+    Decision.c Decision.h
+    DraculaMcts.c DraculaMcts.h
+    HunterMcts.c HunterMcts.h Rollout.c Rollout.h
+    Parallel.c Parallel.h
+    Random.h
+    Arena.c Arena.h
+    Bfs.h
+    Makefile"
+
 for i in {1..10}
 do
-    /web/cs2521/20T2/ass/ass2/hunt/dryrun/rungame.sh hunter.c dracula.c HunterView.c HunterView.h GameView.c GameView.h DraculaView.c DraculaView.h Map.c Map.h Queue.c Queue.h utils.c utils.h Makefile > OUTPUT.txt
+    if [ "$1" = "local" ]
+    then
+        ./referee > OUTPUT.txt
+    else
+        /web/cs2521/20T2/ass/ass2/hunt/dryrun/rungame.sh $FILES > OUTPUT.txt
+    fi
     score=`tail -2 OUTPUT.txt | head -1 | cut -d ' ' -f3`
     echo "The score is:: $score"
-done
\ No newline at end of file
+done
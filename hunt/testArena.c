@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// testArena.c: test the Arena ADT
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Arena.h"
+
+int main(void)
+{
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Allocating and resetting\n");
+		
+		Arena arena = ArenaNew(256);
+		assert(ArenaBytesUsed(arena) == 0);
+		
+		char *a = ArenaAlloc(arena, 10);
+		char *b = ArenaAlloc(arena, 1);
+		assert(a != NULL && b != NULL && a != b);
+		assert((uintptr_t) a % _Alignof(max_align_t) == 0);
+		assert((uintptr_t) b % _Alignof(max_align_t) == 0);
+		assert(ArenaBytesUsed(arena) >= 11);
+		memset(a, 'a', 10);
+		*b = 'b';
+		assert(a[9] == 'a' && *b == 'b');
+		
+		// Past the end of the first block, and bigger than a block
+		int *numbers[100];
+		for (int i = 0; i < 100; i++) {
+			numbers[i] = ArenaAlloc(arena, 71 * sizeof(int));
+			for (int j = 0; j < 71; j++) numbers[i][j] = i;
+		}
+		char *big = ArenaAlloc(arena, 100000);
+		memset(big, 0, 100000);
+		for (int i = 0; i < 100; i++) {
+			assert(numbers[i][0] == i && numbers[i][70] == i);
+		}
+		
+		// After a reset, the memory is used again
+		ArenaReset(arena);
+		assert(ArenaBytesUsed(arena) == 0);
+		char *c = ArenaAlloc(arena, 10);
+		ArenaReset(arena);
+		assert(ArenaAlloc(arena, 10) == c);
+		
+		// and everything from before fits in one block now
+		char *first = ArenaAlloc(arena, 100000);
+		for (int i = 0; i < 100; i++) {
+			char *p = ArenaAlloc(arena, 71 * sizeof(int));
+			assert(p > first && p < first + 200000);
+		}
+		
+		ArenaFree(arena);
+		printf("Test passed!\n");
+	}
+	
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Results come from the arena in use\n");
+		
+		// With no arena in use, they come from malloc
+		int *result = ArenaAllocResult(10 * sizeof(int));
+		result[9] = 1;
+		free(result);
+		
+		Arena arena = ArenaNew(1024);
+		Arena other = ArenaNew(1024);
+		assert(ArenaUse(arena) == NULL);
+		result = ArenaAllocResult(10 * sizeof(int));
+		assert(ArenaBytesUsed(arena) >= 10 * sizeof(int));
+		
+		// Arenas can be used inside one another
+		assert(ArenaUse(other) == arena);
+		ArenaAllocResult(10 * sizeof(int));
+		assert(ArenaBytesUsed(other) >= 10 * sizeof(int));
+		size_t used = ArenaBytesUsed(arena);
+		assert(ArenaUse(arena) == other);
+		ArenaAllocResult(10 * sizeof(int));
+		assert(ArenaBytesUsed(arena) > used);
+		
+		// Freeing the arena in use stops it being used
+		ArenaFree(arena);
+		assert(ArenaUse(NULL) == NULL);
+		ArenaFree(other);
+		
+		printf("Test passed!\n");
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// testBfs.c: test the breadth-first searches
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Bfs.h"
+#include "Map.h"
+#include "PlaceSet.h"
+#include "Places.h"
+
+/** A hunter's moves; arg points to their rail phase for the first. */
+static PlaceSet hunterMoves(PlaceId p, int depth, void *arg)
+{
+	Map map = MapNew();
+	int phase = (*(int *) arg + depth) % MAP_NUM_RAIL_PHASES;
+	PlaceSet s = MapGetRailSet(map, p, phase);
+	s = placeSetUnion(s, MapGetNeighbourSet(map, p, ROAD));
+	s = placeSetUnion(s, MapGetNeighbourSet(map, p, BOAT));
+	return s;
+}
+
+/** Road moves only, counting how often it's called. */
+static PlaceSet roadMoves(PlaceId p, int depth, void *arg)
+{
+	(*(int *) arg)++;
+	return MapGetNeighbourSet(MapNew(), p, ROAD);
+}
+
+static PlaceSet railMoves(PlaceId p, int depth, void *arg)
+{
+	return MapGetNeighbourSet(MapNew(), p, RAIL);
+}
+
+int main(void)
+{
+	Map map = MapNew();
+	
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Searching agrees with the hunter distances\n");
+		
+		for (int phase = 0; phase < MAP_NUM_RAIL_PHASES; phase++) {
+			for (PlaceId src = 0; src < NUM_REAL_PLACES; src++) {
+				int dist[NUM_REAL_PLACES];
+				PlaceId pred[NUM_REAL_PLACES];
+				int numReached = bfsSearch(src, BFS_NO_LIMIT, hunterMoves,
+				                           &phase, dist, pred);
+				assert(numReached == NUM_REAL_PLACES);
+				for (PlaceId p = 0; p < NUM_REAL_PLACES; p++) {
+					assert(dist[p] ==
+					       MapGetHunterDistance(map, phase, src, p));
+					assert(pred[p] ==
+					       MapGetHunterPathPred(map, phase, src, p));
+				}
+			}
+		}
+		
+		printf("Test passed!\n");
+	}
+	
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Searching only so far\n");
+		
+		// Galway is only a road away from Dublin, and Dublin from
+		// nowhere else by road
+		int numCalls = 0;
+		int dist[NUM_REAL_PLACES];
+		int numReached = bfsSearch(GALWAY, 1, roadMoves, &numCalls,
+		                           dist, NULL);
+		assert(numReached == 2);
+		assert(numCalls == 1);
+		assert(dist[GALWAY] == 0 && dist[DUBLIN] == 1);
+		assert(dist[LONDON] == -1);
+		
+		numCalls = 0;
+		assert(bfsSearch(GALWAY, BFS_NO_LIMIT, roadMoves, &numCalls,
+		                 NULL, NULL) == 2);
+		assert(numCalls == 2);
+		
+		// Within 0 steps is just where it starts
+		PlaceSet s = bfsWithin(MADRID, 0, railMoves, NULL);
+		assert(placeSetEquals(s, placeSetOf(MADRID)));
+		
+		printf("Test passed!\n");
+	}
+	
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Layers agree with the rail sets\n");
+		
+		for (PlaceId src = 0; src < NUM_REAL_PLACES; src++) {
+			for (int hops = 0; hops <= MAP_MAX_RAIL_HOPS; hops++) {
+				PlaceSet s = bfsWithin(src, hops, railMoves, NULL);
+				assert(placeSetEquals(s, MapGetRailSet(map, src, hops)));
+			}
+			
+			// The same places as a full search finds
+			int dist[NUM_REAL_PLACES];
+			bfsSearch(src, BFS_NO_LIMIT, railMoves, NULL, dist, NULL);
+			PlaceSet all = bfsWithin(src, BFS_NO_LIMIT, railMoves, NULL);
+			for (PlaceId p = 0; p < NUM_REAL_PLACES; p++) {
+				assert(placeSetContains(all, p) == (dist[p] >= 0));
+			}
+		}
+		
+		printf("Test passed!\n");
+	}
+	
+	MapFree(map);
+	return EXIT_SUCCESS;
+}
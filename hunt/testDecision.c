@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// testDecision.c: test the per-turn clock
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Decision.h"
+#include "Game.h"
+#include "Places.h"
+
+static char latestPlay[3] = "";
+
+// Stands in for the one in player.c
+void registerBestPlay(char *play, Message message)
+{
+	strncpy(latestPlay, play, 2);
+}
+
+static void sleepMsecs(int msecs)
+{
+	struct timespec t = { msecs / 1000, (msecs % 1000) * 1000000L };
+	nanosleep(&t, NULL);
+}
+
+int main(void)
+{
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Keeping time\n");
+		
+		decisionSetBudget(300, 100);
+		decisionBegin();
+		assert(decisionTimeElapsed() < 50);
+		assert(decisionTimeRemaining() > 150);
+		assert(decisionTimeRemaining() <= 200);
+		assert(!decisionTimeUp());
+		
+		sleepMsecs(50);
+		assert(decisionTimeElapsed() >= 50);
+		assert(decisionTimeRemaining() <= 150);
+		assert(!decisionTimeUp());
+		
+		decisionSetBudget(300, 260);
+		assert(decisionTimeUp());
+		
+		decisionSetBudget(300, 300);
+		assert(decisionTimeUp());
+		
+		// A fixed number of iterations replaces the deadline
+		decisionSetIterations(100);
+		assert(decisionIterations() == 100);
+		assert(!decisionTimeUp());
+		decisionSetIterations(0);
+		assert(decisionTimeUp());
+		
+		printf("Test passed!\n");
+	}
+	
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Publishing better moves\n");
+		
+		// The last move published wins
+		decisionBegin();
+		decisionPublish(PARIS, "");
+		decisionPublish(MADRID, "");
+		decisionPublish(PARIS, "");
+		assert(decisionNumPublished() == 3);
+		assert(strcmp(latestPlay, "PA") == 0);
+		
+		// A new decision starts counting again
+		decisionBegin();
+		assert(decisionNumPublished() == 0);
+		
+		printf("Test passed!\n");
+	}
+	
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Seeding each decision\n");
+		
+		// Each decision gets its own seed
+		decisionSetSeed(42);
+		decisionBegin();
+		unsigned int first = decisionSeed();
+		assert(decisionSeed() == first);
+		decisionBegin();
+		unsigned int second = decisionSeed();
+		assert(second != first);
+		
+		// and the same seed gives the same ones again
+		decisionSetSeed(42);
+		decisionBegin();
+		assert(decisionSeed() == first);
+		decisionBegin();
+		assert(decisionSeed() == second);
+		
+		printf("Test passed!\n");
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,191 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// testDraculaMcts.c: test Dracula's Monte Carlo tree search
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Decision.h"
+#include "DraculaMcts.h"
+#include "DraculaView.h"
+#include "Game.h"
+#include "GameView.h"
+#include "Parallel.h"
+#include "Places.h"
+
+// Stands in for the one in player.c
+void registerBestPlay(char *play, Message message)
+{
+}
+
+static int totalVisits(DraculaMcts dm)
+{
+	MctsMoveStats stats[NUM_REAL_PLACES];
+	int numMoves = DmGetRootStats(dm, stats);
+	int visits = 0;
+	for (int i = 0; i < numMoves; i++) {
+		visits += stats[i].visits;
+	}
+	return visits;
+}
+
+int main(void)
+{
+	// Stop on iteration counts, not the clock
+	decisionSetBudget(60 * 1000, 0);
+
+	{///////////////////////////////////////////////////////////////////
+
+		printf("Searching a fixed number of iterations\n");
+
+		char *trail =
+			"GGE.... SGE.... HGE.... MGE.... DKL.V.. "
+			"GGE.... SGE.... HGE.... MGE....";
+
+		Message messages[9] = {};
+		DraculaView dv = DvNew(trail, messages);
+
+		DraculaMcts dm1 = DmNew(2521);
+		DraculaMcts dm2 = DmNew(2521);
+		assert(DmBestMove(dm1) == NOWHERE);
+		assert(DmSearch(dm1, dv, 500) == 500);
+		assert(DmSearch(dm2, dv, 500) == 500);
+		assert(totalVisits(dm1) == 500);
+
+		// Every valid move gets tried, and the same seed gives the
+		// same search
+		int numMoves = -1;
+		PlaceId *moves = DvGetValidMoves(dv, &numMoves);
+		MctsMoveStats stats1[NUM_REAL_PLACES];
+		MctsMoveStats stats2[NUM_REAL_PLACES];
+		assert(DmGetRootStats(dm1, stats1) == numMoves);
+		assert(DmGetRootStats(dm2, stats2) == numMoves);
+		for (int i = 0; i < numMoves; i++) {
+			assert(stats1[i].move == moves[i]);
+			assert(stats1[i].visits > 0);
+			assert(stats1[i].value >= 0.0 && stats1[i].value <= 1.0);
+			assert(stats1[i].visits == stats2[i].visits);
+			assert(stats1[i].value == stats2[i].value);
+		}
+		assert(DmBestMove(dm1) == DmBestMove(dm2));
+		free(moves);
+
+		DmFree(dm1);
+		DmFree(dm2);
+		DvFree(dv);
+		printf("Test passed!\n");
+	}
+
+	{///////////////////////////////////////////////////////////////////
+
+		printf("Keeping away from the hunters\n");
+
+		// All four hunters are in Galatz, next to Dracula
+		char *trail =
+			"GGA.... SGA.... HGA.... MGA.... DKL.V.. "
+			"GGA.... SGA.... HGA.... MGA....";
+
+		Message messages[9] = {};
+		DraculaView dv = DvNew(trail, messages);
+
+		DraculaMcts dm = DmNew(1);
+		DmSearch(dm, dv, 2000);
+		PlaceId move = DmBestMove(dm);
+		assert(move != NOWHERE);
+		assert(DvResolveMove(dv, move) != GALATZ);
+
+		DmFree(dm);
+		DvFree(dv);
+		printf("Test passed!\n");
+	}
+
+	{///////////////////////////////////////////////////////////////////
+
+		printf("Keeping the tree for the same position only\n");
+
+		char *trail =
+			"GGE.... SGE.... HGE.... MGE.... DKL.V.. "
+			"GGE.... SGE.... HGE.... MGE....";
+
+		Message messages[9] = {};
+		DraculaView dv = DvNew(trail, messages);
+
+		DraculaMcts dm = DmNew(7);
+		DmSearch(dm, dv, 1000);
+
+		// Searching the same position again carries on
+		DmSearch(dm, dv, 100);
+		assert(totalVisits(dm) == 1100);
+
+		// Play Dracula's move and the hunters' replies
+		PlaceId move = DmBestMove(dm);
+		GameView gv = DvGetGameView(dv);
+		char play[8];
+		GvBuildPlay(gv, move, play);
+		DvApplyPlay(dv, play);
+		for (Player p = 0; p < PLAYER_DRACULA; p++) {
+			GvBuildPlay(gv, GENEVA, play);
+			DvApplyPlay(dv, play);
+		}
+
+		// The new position gets a new tree
+		DmSearch(dm, dv, 100);
+		assert(totalVisits(dm) == 100);
+
+		DmFree(dm);
+		DvFree(dv);
+		printf("Test passed!\n");
+	}
+
+	{///////////////////////////////////////////////////////////////////
+
+		printf("Searching on several threads\n");
+
+		char *trail =
+			"GGE.... SGE.... HGE.... MGE.... DKL.V.. "
+			"GGE.... SGE.... HGE.... MGE....";
+
+		Message messages[9] = {};
+		DraculaView dv = DvNew(trail, messages);
+
+		// One thread searches just like a single search
+		DraculaMcts dm = DmNew(2521);
+		DmSearch(dm, dv, 500);
+		MctsMoveStats single[NUM_REAL_PLACES];
+		MctsMoveStats merged[NUM_REAL_PLACES];
+		int numMoves = DmGetRootStats(dm, single);
+		assert(DmSearchParallel(dv, 2521, 1, 500, merged) == numMoves);
+		for (int i = 0; i < numMoves; i++) {
+			assert(merged[i].move == single[i].move);
+			assert(merged[i].visits == single[i].visits);
+			assert(merged[i].value == single[i].value);
+		}
+		assert(parallelBestMove(merged, numMoves) == DmBestMove(dm));
+
+		// Several threads add up their visits
+		assert(DmSearchParallel(dv, 2521, 4, 300, merged) == numMoves);
+		int visits = 0;
+		for (int i = 0; i < numMoves; i++) {
+			assert(merged[i].move == single[i].move);
+			assert(merged[i].value >= 0.0 && merged[i].value <= 1.0);
+			visits += merged[i].visits;
+		}
+		assert(visits == 4 * 300);
+
+		parallelSetThreads(MAX_THREADS + 1);
+		assert(parallelNumThreads() == MAX_THREADS);
+		parallelSetThreads(0);
+		assert(parallelNumThreads() >= 1);
+
+		DmFree(dm);
+		DvFree(dv);
+		printf("Test passed!\n");
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -166,5 +166,52 @@ int main(void)
 		DvFree(dv);
 	}
 
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Test for searching ahead\n");
+		
+		char *trail =
+			"GGE.... SGE.... HGE.... MGE.... DKL.V.. "
+			"GGE.... SGE.... HGE.... MGE.... DD1T... "
+			"GGE.... SGE.... HGE.... MGE....";
+		
+		Message messages[14] = {};
+		DraculaView dv = DvNew(trail, messages);
+		DraculaView copy = DvClone(dv);
+		
+		assert(DvResolveMove(dv, HIDE) == KLAUSENBURG);
+		assert(DvResolveMove(dv, DOUBLE_BACK_1) == KLAUSENBURG);
+		assert(DvResolveMove(dv, TELEPORT) == CASTLE_DRACULA);
+		assert(DvResolveMove(dv, GALATZ) == GALATZ);
+		
+		// Dracula moves on, and a hunter follows him
+		DvMakeMove(copy, CASTLE_DRACULA);
+		DvMakeMove(copy, CASTLE_DRACULA);
+		assert(DvGetPlayerLocation(copy, PLAYER_LORD_GODALMING)
+		       == CASTLE_DRACULA);
+		assert(DvGetHealth(copy, PLAYER_DRACULA) ==
+		       GAME_START_BLOOD_POINTS + LIFE_GAIN_CASTLE_DRACULA
+		       - LIFE_LOSS_HUNTER_ENCOUNTER);
+		
+		// Taking the moves back leaves the copy as it started
+		DvUnmakeMove(copy);
+		DvUnmakeMove(copy);
+		assert(GvGetHash(DvGetGameView(copy)) ==
+		       GvGetHash(DvGetGameView(dv)));
+		int numMoves = -1, numCopyMoves = -1;
+		PlaceId *moves = DvGetValidMoves(dv, &numMoves);
+		PlaceId *copyMoves = DvGetValidMoves(copy, &numCopyMoves);
+		assert(numCopyMoves == numMoves);
+		for (int i = 0; i < numMoves; i++) {
+			assert(copyMoves[i] == moves[i]);
+		}
+		free(moves);
+		free(copyMoves);
+		
+		printf("Test passed!\n");
+		DvFree(copy);
+		DvFree(dv);
+	}
+
 	return EXIT_SUCCESS;
 }
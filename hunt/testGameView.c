@@ -14,6 +14,7 @@
 
 #include <assert.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -494,6 +495,263 @@ int main(void)
 		printf("Test passed!\n");
 	}
 
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Applying plays one at a time\n");
+		
+		char *trail =
+			"GGE.... SGE.... HGE.... MGE.... DC?.V.. "
+			"GGE.... SGE.... HGE.... MGE.... DSTT... "
+			"GGE.... SGE.... HGE.... MGE.... DHIT... "
+			"GGE.... SGE.... HGE.... MGE.... DD1T... "
+			"GSTTTTD SGE.... HGE.... MGE.... DC?T... "
+			"GGE....";
+		
+		Message messages[26] = {};
+		GameView expected = GvNew(trail, messages);
+		GameView gv = GvNew("", messages);
+		
+		int numPlays = (strlen(trail) + 1) / 8;
+		for (int i = 0; i < numPlays; i++) {
+			GvApplyPlay(gv, &trail[i * 8]);
+		}
+		
+		assert(GvGetRound(gv) == GvGetRound(expected));
+		assert(GvGetPlayer(gv) == GvGetPlayer(expected));
+		assert(GvGetScore(gv) == GvGetScore(expected));
+		for (int p = 0; p < NUM_PLAYERS; p++) {
+			assert(GvGetHealth(gv, p) == GvGetHealth(expected, p));
+			assert(GvGetPlayerLocation(gv, p) ==
+			       GvGetPlayerLocation(expected, p));
+		}
+		assert(GvGetVampireLocation(gv) == GvGetVampireLocation(expected));
+		
+		int numMoves = -1; bool canFree = false;
+		PlaceId *moves = GvGetMoveHistory(gv, PLAYER_DRACULA,
+		                                  &numMoves, &canFree);
+		assert(numMoves == 5);
+		assert(moves[2] == HIDE);
+		assert(moves[3] == DOUBLE_BACK_1);
+		if (canFree) free(moves);
+		
+		GvFree(expected);
+		GvFree(gv);
+		printf("Test passed!\n");
+	}
+
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Making and unmaking moves\n");
+		
+		char *trail =
+			"GGE.... SGE.... HGE.... MGE.... DC?.V.. "
+			"GGE.... SGE.... HGE.... MGE.... DSTT... "
+			"GGE.... SGE.... HGE.... MGE.... DHIT...";
+		char *moves =
+			"GGE.... SGE.... HGE.... MGE.... DD1T... "
+			"GSTTTTD SGE.... HGE.... MGE.... DC?T.V.";
+		
+		Message messages[15] = {};
+		GameView gv = GvNew(trail, messages);
+		GameView clone = GvNew("", NULL);
+		GvCloneInto(clone, gv);
+		
+		int numMoves = (strlen(moves) + 1) / 8;
+		for (int i = 0; i < numMoves; i++) {
+			GvMakeMove(gv, &moves[i * 8]);
+		}
+		assert(GvGetRound(gv) == 5);
+		assert(GvGetPlayerLocation(gv, PLAYER_LORD_GODALMING) ==
+		       ST_JOSEPH_AND_ST_MARY);
+		assert(GvGetVampireLocation(gv) == NOWHERE);
+		
+		for (int i = 0; i < numMoves; i++) {
+			GvUnmakeMove(gv);
+		}
+		
+		assert(GvGetRound(gv) == GvGetRound(clone));
+		assert(GvGetPlayer(gv) == GvGetPlayer(clone));
+		assert(GvGetScore(gv) == GvGetScore(clone));
+		for (int p = 0; p < NUM_PLAYERS; p++) {
+			assert(GvGetHealth(gv, p) == GvGetHealth(clone, p));
+			assert(GvGetPlayerLocation(gv, p) ==
+			       GvGetPlayerLocation(clone, p));
+		}
+		assert(GvGetVampireLocation(gv) == GvGetVampireLocation(clone));
+		
+		int numTraps = 0;
+		PlaceId *traps = GvGetTrapLocations(gv, &numTraps);
+		assert(numTraps == 2);
+		assert(traps[0] == STRASBOURG && traps[1] == STRASBOURG);
+		free(traps);
+		
+		GvFree(clone);
+		GvFree(gv);
+		printf("Test passed!\n");
+	}
+
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Hashing game states\n");
+		
+		Message messages[16] = {};
+		GameView gv1 = GvNew(
+			"GGE.... SGE.... HGE.... MGE.... DCD.V.. "
+			"GST.... SGE.... HGE.... MGE.... DGAT... "
+			"GGE....", messages);
+		GameView gv2 = GvNew(
+			"GGE.... SGE.... HGE.... MGE.... DCD.V.. "
+			"GZU.... SGE.... HGE.... MGE.... DGAT... "
+			"GGE....", messages);
+		
+		// Same position, reached differently
+		assert(GvGetHash(gv1) == GvGetHash(gv2));
+		
+		uint64_t hash = GvGetHash(gv1);
+		GvMakeMove(gv1, "SZU....");
+		assert(GvGetHash(gv1) != hash);
+		GvMakeMove(gv1, "HZU....");
+		GvUnmakeMove(gv1);
+		GvUnmakeMove(gv1);
+		assert(GvGetHash(gv1) == hash);
+		
+		// The same hunter moves in a different round
+		GameView gv3 = GvNew(
+			"GGE.... SGE.... HGE.... MGE.... DCD.V.. "
+			"GST.... SGE.... HGE.... MGE.... DGAT... "
+			"GGE.... SGE.... HGE.... MGE.... DCNT...", messages);
+		assert(GvGetHash(gv1) != GvGetHash(gv3));
+		
+		GvFree(gv1);
+		GvFree(gv2);
+		GvFree(gv3);
+		printf("Test passed!\n");
+	}
+
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Reachable sets\n");
+		
+		Message messages[] = {};
+		GameView gv = GvNew("", messages);
+		
+		// The set version agrees with the array version everywhere
+		for (int player = 0; player < NUM_PLAYERS; player++) {
+			for (Round round = 0; round < 4; round++) {
+				for (PlaceId from = MIN_REAL_PLACE;
+				     from <= MAX_REAL_PLACE; from++) {
+					int numLocs = -1;
+					PlaceId *locs = GvGetReachableByType(gv, player,
+						round, from, true, true, true, &numLocs);
+					PlaceSet set = GvGetReachableSet(gv, player, round,
+						from, true, true, true);
+					assert(placeSetSize(set) == numLocs);
+					for (int i = 0; i < numLocs; i++) {
+						assert(placeSetContains(set, locs[i]));
+					}
+					free(locs);
+				}
+			}
+		}
+		
+		// Paris by rail, 3 hops, includes Paris itself
+		PlaceSet rail = GvGetReachableSet(gv, PLAYER_LORD_GODALMING, 3,
+		                                  PARIS, false, true, false);
+		assert(placeSetContains(rail, PARIS));
+		assert(placeSetContains(rail, MARSEILLES));
+		assert(placeSetContains(rail, BARCELONA));
+		rail = GvGetReachableSet(gv, PLAYER_LORD_GODALMING, 2,
+		                         PARIS, false, true, false);
+		assert(placeSetSize(rail) == 7);
+		assert(!placeSetContains(rail, BARCELONA));
+		
+		// Dracula never gets the hospital
+		PlaceSet drac = GvGetReachableSet(gv, PLAYER_DRACULA, 0,
+		                                  SZEGED, true, true, true);
+		assert(!placeSetContains(drac, ST_JOSEPH_AND_ST_MARY));
+		assert(placeSetContains(drac, SZEGED));
+		assert(placeSetContains(drac, BELGRADE));
+		
+		GvFree(gv);
+		printf("Test passed!\n");
+	}
+
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Building plays\n");
+		
+		char *plays =
+			"GGE.... SGE.... HGE.... MGE.... DED.V.. "
+			"GST.... SST.... HST.... MST.... DMNT... "
+			"GST.... SST.... HST.... MST.... DLOT... "
+			"GST.... SST.... HST.... MST.... DHIT... "
+			"GMNT... SST.... HLOTTD. MST.... DEC.... "
+			"GST.... SST.... HLO.... MST.... DNS.... "
+			"GST.... SST.... HST.... MST.... DAMT.V. "
+			"GST.... SST.... HST.... MST.... DBUT... "
+			"GAMT... SST.... HST.... MST....";
+		
+		// Each play is what GvBuildPlay makes of its move
+		Message messages[] = {};
+		GameView gv = GvNew("", messages);
+		for (int i = 0; i < strlen(plays); i += 8) {
+			char abbrev[3] = { plays[i + 1], plays[i + 2], '\0' };
+			char play[8];
+			GvBuildPlay(gv, placeAbbrevToId(abbrev), play);
+			assert(strncmp(play, &plays[i], 7) == 0);
+			GvMakeMove(gv, play);
+		}
+		
+		// The vampire has matured
+		assert(GvGetVampireLocation(gv) == NOWHERE);
+		assert(GvGetScore(gv) == GAME_START_SCORE - 8
+		                         - SCORE_LOSS_VAMPIRE_MATURES);
+		
+		// Hiding in Budapest leaves another trap, and nothing drops off
+		// the trail, since the hunter set off the traps in London
+		char play[8];
+		GvBuildPlay(gv, HIDE, play);
+		assert(strcmp(play, "DHIT...") == 0);
+		
+		GvFree(gv);
+		printf("Test passed!\n");
+	}
+	
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Building plays into a full city\n");
+		
+		// Dracula leaves traps in Castle Dracula three rounds running,
+		// then teleports back there when a vampire is due
+		char *moves[] = {
+			"ST", "ZU", "MI", "VE", "MU", "VI", "BD", "SZ", "KL", "GA",
+			"CD", "HI", "D1",
+		};
+		Message messages[] = {};
+		GameView gv = GvNew("", messages);
+		char play[8];
+		for (int i = 0; i < 13; i++) {
+			for (Player p = 0; p < PLAYER_DRACULA; p++) {
+				GvBuildPlay(gv, GENEVA, play);
+				GvMakeMove(gv, play);
+			}
+			GvBuildPlay(gv, placeAbbrevToId(moves[i]), play);
+			GvMakeMove(gv, play);
+		}
+		for (Player p = 0; p < PLAYER_DRACULA; p++) {
+			GvBuildPlay(gv, GENEVA, play);
+			GvMakeMove(gv, play);
+		}
+		
+		// The city already holds three encounters, so there's no room
+		// for the vampire
+		GvBuildPlay(gv, TELEPORT, play);
+		assert(strcmp(play, "DTP..M.") == 0);
+		
+		GvFree(gv);
+		printf("Test passed!\n");
+	}
+
 	return EXIT_SUCCESS;
 }
 
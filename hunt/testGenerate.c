@@ -0,0 +1,242 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// testGenerate.c: test the random game generator
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "DraculaView.h"
+#include "Game.h"
+#include "GameView.h"
+#include "Generate.h"
+#include "PlaceSet.h"
+#include "Places.h"
+#include "Random.h"
+
+#define PLAY_SIZE 8
+
+/**
+ * Checks that each play in a game is a legal move for whoever made it,
+ * and is written the way GvBuildPlay would write it
+ */
+static void assertLegal(const char *pastPlays, int numPlays)
+{
+	assert((int) strlen(pastPlays) == numPlays * PLAY_SIZE - 1);
+	DraculaView dv = DvNew("", NULL);
+	GameView gv = DvGetGameView(dv);
+	for (int i = 0; i < numPlays; i++) {
+		const char *play = &pastPlays[i * PLAY_SIZE];
+		Player player = GvGetPlayer(gv);
+		char abbrev[3] = { play[1], play[2], '\0' };
+		PlaceId move = placeAbbrevToId(abbrev);
+		assert(play[0] == "GSHMD"[player]);
+		
+		if (GvGetRound(gv) == 0) {
+			assert(placeIsLand(move) && move != HOSPITAL_PLACE);
+		} else if (player == PLAYER_DRACULA) {
+			PlaceId moves[NUM_REAL_PLACES];
+			int numMoves = DvFillValidMoves(dv, moves);
+			bool valid = numMoves == 0 && move == TELEPORT;
+			for (int j = 0; j < numMoves; j++) {
+				valid = valid || moves[j] == move;
+			}
+			assert(valid);
+		} else {
+			PlaceId from = GvGetPlayerLocation(gv, player);
+			PlaceSet reachable = GvGetReachableSet(gv, player,
+			                                       GvGetRound(gv), from,
+			                                       true, true, true);
+			assert(placeSetContains(reachable, move));
+		}
+		
+		char built[PLAY_SIZE];
+		GvBuildPlay(gv, move, built);
+		assert(strncmp(built, play, PLAY_SIZE - 1) == 0);
+		DvApplyPlay(dv, play);
+	}
+	DvFree(dv);
+}
+
+/** Sends the hunters nowhere after their first move */
+static PlaceId restingHunters(DraculaView dv, void *arg)
+{
+	GameView gv = DvGetGameView(dv);
+	PlaceId here = GvGetPlayerLocation(gv, GvGetPlayer(gv));
+	(*(int *) arg)++;
+	return placeIsReal(here) ? here : NOWHERE;
+}
+
+int main(void)
+{
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Generated games are legal\n");
+		
+		GeneratePolicy policies[] = {
+			GENERATE_UNIFORM, GENERATE_GREEDY, GENERATE_CAUTIOUS
+		};
+		for (int p = 0; p < 3; p++) {
+			for (unsigned int s = 1; s <= 10; s++) {
+				GenerateOptions options = {
+					.dracula = policies[p],
+					.hunters = policies[(p + s) % 3],
+				};
+				Random rng;
+				randomSeed(&rng, s);
+				int numPlays = 0;
+				char *pastPlays = generateGame(&options, 100, &rng,
+				                               &numPlays);
+				assert(numPlays > 0 && numPlays <= 100 * NUM_PLAYERS);
+				assertLegal(pastPlays, numPlays);
+				
+				// It stopped because the game was over
+				if (numPlays < 100 * NUM_PLAYERS) {
+					GameView gv = GvNew(pastPlays, NULL);
+					assert(GvGetScore(gv) <= 0
+					       || GvGetHealth(gv, PLAYER_DRACULA) <= 0);
+					GvFree(gv);
+				}
+				free(pastPlays);
+			}
+		}
+		
+		printf("Test passed!\n");
+	}
+	
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("The same seed gives the same game\n");
+		
+		GenerateOptions options = {
+			.dracula = GENERATE_UNIFORM,
+			.hunters = GENERATE_GREEDY,
+		};
+		Random rng1, rng2, rng3;
+		randomSeed(&rng1, 42);
+		randomSeed(&rng2, 42);
+		randomSeed(&rng3, 43);
+		int n1 = 0, n2 = 0, n3 = 0;
+		char *game1 = generateGame(&options, 50, &rng1, &n1);
+		char *game2 = generateGame(&options, 50, &rng2, &n2);
+		char *game3 = generateGame(&options, 50, &rng3, &n3);
+		assert(n1 == n2 && strcmp(game1, game2) == 0);
+		assert(rng1.state == rng2.state);
+		assert(strcmp(game1, game3) != 0);
+		free(game1);
+		free(game2);
+		free(game3);
+		
+		printf("Test passed!\n");
+	}
+	
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Games can be played on past their end\n");
+		
+		GenerateOptions options = {
+			.dracula = GENERATE_UNIFORM,
+			.hunters = GENERATE_GREEDY,
+		};
+		Random rng;
+		randomSeed(&rng, 1);
+		int numPlays = 0;
+		char *pastPlays = generateGame(&options, 400, &rng, &numPlays);
+		assert(numPlays < 400 * NUM_PLAYERS);
+		free(pastPlays);
+		
+		options.pastEnd = true;
+		randomSeed(&rng, 1);
+		pastPlays = generateGame(&options, 400, &rng, &numPlays);
+		assert(numPlays == 400 * NUM_PLAYERS);
+		assert((int) strlen(pastPlays) == numPlays * PLAY_SIZE - 1);
+		free(pastPlays);
+		
+		printf("Test passed!\n");
+	}
+	
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Scripted moves, and carrying on from a position\n");
+		
+		int numCalls = 0;
+		GenerateOptions options = {
+			.dracula = GENERATE_CAUTIOUS,
+			.hunters = GENERATE_SCRIPTED,
+			.script = restingHunters,
+			.scriptArg = &numCalls,
+		};
+		DraculaView dv = DvNew("GMN.... SGA.... HFR.... MMA....", NULL);
+		char plays[10 * NUM_PLAYERS * PLAY_SIZE];
+		Random rng;
+		randomSeed(&rng, 1);
+		int numPlays = generatePlays(dv, &options, 10 * NUM_PLAYERS - 4,
+		                             &rng, plays);
+		assert(numPlays == 10 * NUM_PLAYERS - 4);
+		assert(numCalls == 9 * (NUM_PLAYERS - 1));
+		assert(DvGetRound(dv) == 10);
+		
+		// Dracula keeps away from them, so they stay put
+		for (int i = 0; i < numPlays; i++) {
+			if (i % NUM_PLAYERS == 0) continue; // Dracula's
+			assert(strncmp(&plays[i * PLAY_SIZE], "GMN", 3) == 0
+			    || strncmp(&plays[i * PLAY_SIZE], "SGA", 3) == 0
+			    || strncmp(&plays[i * PLAY_SIZE], "HFR", 3) == 0
+			    || strncmp(&plays[i * PLAY_SIZE], "MMA", 3) == 0);
+		}
+		DvFree(dv);
+		
+		printf("Test passed!\n");
+	}
+	
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Hiding Dracula's moves from the hunters\n");
+		
+		// Castle Dracula is always shown; Galatz because he moved onto
+		// Dr Seward; Klausenburg once Dr Seward runs into his trap
+		// there; Bucharest isn't
+		PlaceId moves[] = {
+			MUNICH, GALATZ, FRANKFURT, MADRID, CASTLE_DRACULA,
+			MUNICH, GALATZ, FRANKFURT, MADRID, GALATZ,
+			MUNICH, GALATZ, FRANKFURT, MADRID, KLAUSENBURG,
+			MUNICH, KLAUSENBURG, FRANKFURT, MADRID, BUCHAREST,
+		};
+		int numPlays = sizeof(moves) / sizeof(moves[0]);
+		char pastPlays[20 * PLAY_SIZE];
+		GameView gv = GvNew("", NULL);
+		for (int i = 0; i < numPlays; i++) {
+			char *play = &pastPlays[i * PLAY_SIZE];
+			GvBuildPlay(gv, moves[i], play);
+			GvApplyPlay(gv, play);
+			play[PLAY_SIZE - 1] = ' ';
+		}
+		pastPlays[numPlays * PLAY_SIZE - 1] = '\0';
+		
+		char hunterPlays[20 * PLAY_SIZE];
+		generateHunterPlays(gv, pastPlays, hunterPlays);
+		assert(strncmp(&hunterPlays[4 * PLAY_SIZE], "DCD", 3) == 0);
+		assert(strncmp(&hunterPlays[9 * PLAY_SIZE], "DGA", 3) == 0);
+		assert(strncmp(&hunterPlays[14 * PLAY_SIZE], "DKL", 3) == 0);
+		assert(strncmp(&hunterPlays[19 * PLAY_SIZE], "DC?", 3) == 0);
+		
+		// Everything else is as it was
+		for (int i = 0; i < (int) strlen(pastPlays); i++) {
+			assert(hunterPlays[i] == pastPlays[i] || i == 19 * PLAY_SIZE + 1
+			       || i == 19 * PLAY_SIZE + 2);
+		}
+		
+		// It can hide them in place too
+		generateHunterPlays(gv, pastPlays, pastPlays);
+		assert(strcmp(pastPlays, hunterPlays) == 0);
+		GvFree(gv);
+		
+		printf("Test passed!\n");
+	}
+	
+	return EXIT_SUCCESS;
+}
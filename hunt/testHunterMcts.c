@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// testHunterMcts.c: test the hunters' Monte Carlo tree search
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Decision.h"
+#include "Game.h"
+#include "HunterMcts.h"
+#include "HunterView.h"
+#include "Parallel.h"
+#include "Places.h"
+
+// Stands in for the one in player.c
+void registerBestPlay(char *play, Message message)
+{
+}
+
+int main(void)
+{
+	// Stop on iteration counts, not the clock
+	decisionSetBudget(60 * 1000, 0);
+
+	{///////////////////////////////////////////////////////////////////
+
+		printf("Searching a fixed number of iterations\n");
+
+		// Dracula's moves so far are hidden
+		char *trail =
+			"GGE.... SGE.... HGE.... MGE.... DC?.V.. "
+			"GGE.... SGE.... HGE.... MGE.... DC?T...";
+
+		Message messages[10] = {};
+		HunterView hv = HvNew(trail, messages);
+
+		HunterMcts hm1 = HmNew(2521);
+		HunterMcts hm2 = HmNew(2521);
+		assert(HmBestMove(hm1) == NOWHERE);
+		assert(HmSearch(hm1, hv, 500) == 500);
+		assert(HmSearch(hm2, hv, 500) == 500);
+
+		// Every move Lord Godalming can make gets tried, and the same
+		// seed gives the same search
+		int numMoves = -1;
+		PlaceId *moves = HvWhereCanIGo(hv, &numMoves);
+		MctsMoveStats stats1[NUM_REAL_PLACES];
+		MctsMoveStats stats2[NUM_REAL_PLACES];
+		assert(HmGetRootStats(hm1, stats1) == numMoves);
+		assert(HmGetRootStats(hm2, stats2) == numMoves);
+		int visits = 0;
+		for (int i = 0; i < numMoves; i++) {
+			bool found = false;
+			for (int j = 0; j < numMoves; j++) {
+				found = found || moves[j] == stats1[i].move;
+			}
+			assert(found);
+			assert(stats1[i].visits > 0);
+			assert(stats1[i].value >= 0.0 && stats1[i].value <= 1.0);
+			assert(stats1[i].move == stats2[i].move);
+			assert(stats1[i].visits == stats2[i].visits);
+			assert(stats1[i].value == stats2[i].value);
+			visits += stats1[i].visits;
+		}
+		assert(visits == 500);
+		assert(HmBestMove(hm1) == HmBestMove(hm2));
+		free(moves);
+
+		HmFree(hm1);
+		HmFree(hm2);
+		HvFree(hv);
+		printf("Test passed!\n");
+	}
+
+	{///////////////////////////////////////////////////////////////////
+
+		printf("Catching Dracula where he was last seen\n");
+
+		// Dracula is in Klausenburg, next to Lord Godalming in Budapest
+		char *trail =
+			"GBD.... SGE.... HGE.... MGE.... DKL.V..";
+
+		Message messages[5] = {};
+		HunterView hv = HvNew(trail, messages);
+
+		HunterMcts hm = HmNew(1);
+		HmSearch(hm, hv, 2000);
+		assert(HmBestMove(hm) == KLAUSENBURG);
+
+		HmFree(hm);
+		HvFree(hv);
+		printf("Test passed!\n");
+	}
+
+	{///////////////////////////////////////////////////////////////////
+
+		printf("Searching on several threads\n");
+
+		char *trail =
+			"GGE.... SGE.... HGE.... MGE.... DC?.V.. "
+			"GGE.... SGE.... HGE.... MGE.... DC?T...";
+
+		Message messages[10] = {};
+		HunterView hv = HvNew(trail, messages);
+
+		// One thread searches just like a single search
+		HunterMcts hm = HmNew(2521);
+		HmSearch(hm, hv, 500);
+		MctsMoveStats single[NUM_REAL_PLACES];
+		MctsMoveStats merged[NUM_REAL_PLACES];
+		int numMoves = HmGetRootStats(hm, single);
+		assert(HmSearchParallel(hv, 2521, 1, 500, merged) == numMoves);
+		for (int i = 0; i < numMoves; i++) {
+			assert(merged[i].move == single[i].move);
+			assert(merged[i].visits == single[i].visits);
+			assert(merged[i].value == single[i].value);
+		}
+		assert(parallelBestMove(merged, numMoves) == HmBestMove(hm));
+
+		// Several threads add up their visits
+		assert(HmSearchParallel(hv, 2521, 4, 300, merged) == numMoves);
+		int visits = 0;
+		for (int i = 0; i < numMoves; i++) {
+			assert(merged[i].value >= 0.0 && merged[i].value <= 1.0);
+			visits += merged[i].visits;
+		}
+		assert(visits == 4 * 300);
+
+		HmFree(hm);
+		HvFree(hv);
+		printf("Test passed!\n");
+	}
+
+	return EXIT_SUCCESS;
+}
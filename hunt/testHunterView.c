@@ -13,6 +13,7 @@
 ////////////////////////////////////////////////////////////////////////
 
 #include <assert.h>
+#include <math.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -21,6 +22,7 @@
 #include "Game.h"
 #include "HunterView.h"
 #include "Places.h"
+#include "Random.h"
 #include "testUtils.h"
 
 int main(void)
@@ -469,6 +471,295 @@ int main(void)
 		printf("Test passed!\n");	
 	}
 	
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Testing distances\n");
+		
+		char *trail =
+			"GLS.... SLS.... HSW.... MMR.... DCD.V..";
+		
+		Message messages[5] = {};
+		HunterView hv = HvNew(trail, messages);
+		
+		assert(HvGetDistance(hv, PLAYER_LORD_GODALMING, LISBON) == 0);
+		assert(HvGetDistance(hv, PLAYER_LORD_GODALMING, BARCELONA) == 2);
+		assert(HvGetDistance(hv, PLAYER_VAN_HELSING, HAMBURG) == 3);
+		assert(HvGetDistance(hv, PLAYER_DR_SEWARD, CASTLE_DRACULA) == 7);
+		
+		// Distances agree with the paths everywhere
+		for (Player hunter = 0; hunter < PLAYER_DRACULA; hunter++) {
+			for (PlaceId dest = MIN_REAL_PLACE; dest <= MAX_REAL_PLACE;
+			     dest++) {
+				int pathLength = -1;
+				PlaceId *path = HvGetShortestPathTo(hv, hunter, dest,
+				                                    &pathLength);
+				assert(HvGetDistance(hv, hunter, dest) == pathLength);
+				if (pathLength > 0) assert(path[pathLength - 1] == dest);
+				free(path);
+			}
+		}
+		
+		HvFree(hv);
+		
+		// Nobody has moved yet
+		hv = HvNew("", messages);
+		assert(HvGetDistance(hv, PLAYER_LORD_GODALMING, LISBON) == -1);
+		HvFree(hv);
+		printf("Test passed!\n");
+	}
+	
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Testing distance fields\n");
+		
+		char *trail =
+			"GLS.... SLS.... HSW.... MMR.... DCD.V..";
+		
+		Message messages[5] = {};
+		HunterView hv = HvNew(trail, messages);
+		
+		int distances[NUM_REAL_PLACES];
+		PlaceId pred[NUM_REAL_PLACES];
+		HvGetDistancesFrom(hv, PLAYER_MINA_HARKER, distances);
+		HvGetPathPredecessors(hv, PLAYER_MINA_HARKER, pred);
+		assert(distances[MARSEILLES] == 0 && pred[MARSEILLES] == MARSEILLES);
+		assert(distances[CONSTANTA] == 4);
+		
+		// Walking back from Constanta gives the same path
+		int pathLength = -1;
+		PlaceId *path = HvGetShortestPathTo(hv, PLAYER_MINA_HARKER,
+		                                    CONSTANTA, &pathLength);
+		PlaceId curr = CONSTANTA;
+		for (int i = pathLength - 1; i >= 0; i--) {
+			assert(path[i] == curr);
+			curr = pred[curr];
+		}
+		assert(curr == MARSEILLES);
+		free(path);
+		
+		// Everyone moves next in round 1, so a place d moves away is
+		// reached in round d, and the hunters' own places in round 0
+		Round arrivals[NUM_REAL_PLACES];
+		Player nearest[NUM_REAL_PLACES];
+		HvGetEarliestArrivals(hv, arrivals, nearest);
+		assert(arrivals[LISBON] == 0 && nearest[LISBON] == PLAYER_LORD_GODALMING);
+		assert(arrivals[SWANSEA] == 0 && nearest[SWANSEA] == PLAYER_VAN_HELSING);
+		assert(arrivals[MARSEILLES] == 0);
+		assert(arrivals[HAMBURG] == 3);
+		assert(nearest[HAMBURG] == PLAYER_LORD_GODALMING); // ties Van Helsing
+		for (PlaceId p = MIN_REAL_PLACE; p <= MAX_REAL_PLACE; p++) {
+			int best = -1;
+			for (Player hunter = 0; hunter < PLAYER_DRACULA; hunter++) {
+				int d = HvGetDistance(hv, hunter, p);
+				if (best == -1 || d < best) best = d;
+			}
+			assert(arrivals[p] == best);
+		}
+		
+		HvFree(hv);
+		printf("Test passed!\n");
+	}
+	
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Tracking Dracula's possible locations\n");
+		
+		Message messages[20] = {};
+		HunterView hv = HvNew("GGE.... SGE.... HGE.... MGE....", messages);
+		assert(placeSetIsEmpty(HvGetDraculaPossibleLocations(hv)));
+		
+		// Anywhere but the hospital, and not at sea
+		HvApplyPlay(hv, "DC?.V..");
+		PlaceSet possible = HvGetDraculaPossibleLocations(hv);
+		assert(!placeSetContains(possible, ST_JOSEPH_AND_ST_MARY));
+		assert(!placeSetContains(possible, NORTH_SEA));
+		assert(placeSetContains(possible, PARIS));
+		HvFree(hv);
+		
+		hv = HvNew(
+			"GGE.... SGE.... HGE.... MGE.... DCD.V.. "
+			"GGE.... SGE.... HGE.... MGE.... DC?T...", messages);
+		possible = HvGetDraculaPossibleLocations(hv);
+		assert(placeSetSize(possible) == 2);
+		assert(placeSetContains(possible, GALATZ));
+		assert(placeSetContains(possible, KLAUSENBURG));
+		
+		// Lord Godalming goes to Galatz and doesn't find him
+		HvApplyPlay(hv, "GGA....");
+		possible = HvGetDraculaPossibleLocations(hv);
+		assert(placeSetEquals(possible, placeSetOf(KLAUSENBURG)));
+		
+		// He can't go back to Castle Dracula while it's in his trail
+		HvApplyPlay(hv, "SGE....");
+		HvApplyPlay(hv, "HGE....");
+		HvApplyPlay(hv, "MGE....");
+		HvApplyPlay(hv, "DC?T...");
+		possible = HvGetDraculaPossibleLocations(hv);
+		assert(!placeSetContains(possible, CASTLE_DRACULA));
+		assert(!placeSetContains(possible, KLAUSENBURG));
+		assert(placeSetContains(possible, BUDAPEST));
+		assert(placeSetContains(possible, GALATZ));
+		
+		// Hiding keeps him where he is, and a double back to Klausenburg
+		// narrows it down again
+		HvApplyPlay(hv, "GGA....");
+		HvApplyPlay(hv, "SGE....");
+		HvApplyPlay(hv, "HGE....");
+		HvApplyPlay(hv, "MGE....");
+		HvApplyPlay(hv, "DHIT...");
+		PlaceSet hidden = HvGetDraculaPossibleLocations(hv);
+		assert(!placeSetContains(hidden, GALATZ));
+		assert(placeSetContains(hidden, BUDAPEST));
+		HvApplyPlay(hv, "GGA....");
+		HvApplyPlay(hv, "SGE....");
+		HvApplyPlay(hv, "HGE....");
+		HvApplyPlay(hv, "MGE....");
+		HvApplyPlay(hv, "DD3T...");
+		possible = HvGetDraculaPossibleLocations(hv);
+		assert(placeSetEquals(possible, placeSetOf(KLAUSENBURG)));
+		
+		// A hunter who meets him pins him down
+		HvApplyPlay(hv, "GKLD...");
+		possible = HvGetDraculaPossibleLocations(hv);
+		assert(placeSetEquals(possible, placeSetOf(KLAUSENBURG)));
+		
+		HvFree(hv);
+		
+		// Meeting the vampire says where he was when he left it, and so
+		// where he could have gone since
+		hv = HvNew(
+			"GST.... SGE.... HGE.... MGE.... DC?.V.. "
+			"GST.... SGE.... HGE.... MGE.... DC?....", messages);
+		HvApplyPlay(hv, "GZUV...");
+		possible = HvGetDraculaPossibleLocations(hv);
+		assert(placeSetContains(possible, MUNICH));
+		assert(placeSetContains(possible, MILAN));
+		assert(!placeSetContains(possible, ZURICH));
+		assert(!placeSetContains(possible, PARIS));
+		assert(HvGetDraculaProbability(hv, PARIS) == 0.0f);
+		HvFree(hv);
+		
+		// And so does a trap, if only one of his moves could have left it
+		hv = HvNew(
+			"GST.... SGE.... HGE.... MGE.... DC?T... "
+			"GST.... SGE.... HGE.... MGE.... DC?....", messages);
+		HvApplyPlay(hv, "GZUT...");
+		possible = HvGetDraculaPossibleLocations(hv);
+		assert(placeSetContains(possible, MUNICH));
+		assert(!placeSetContains(possible, PARIS));
+		HvFree(hv);
+		printf("Test passed!\n");
+	}
+	
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Dracula's location distribution\n");
+		
+		Message messages[20] = {};
+		HunterView hv = HvNew("GGE.... SGE.... HGE.... MGE....", messages);
+		PlaceId places[5];
+		float probs[5];
+		assert(HvGetLikelyDraculaLocations(hv, 5, places, probs) == 0);
+		HvFree(hv);
+		
+		hv = HvNew(
+			"GGE.... SGE.... HGE.... MGE.... DCD.V.. "
+			"GGE.... SGE.... HGE.... MGE.... DC?T...", messages);
+		
+		// Equally likely to have gone to either place
+		assert(HvGetLikelyDraculaLocations(hv, 5, places, probs) == 2);
+		assert(places[0] == GALATZ && places[1] == KLAUSENBURG);
+		assert(fabsf(probs[0] - 0.5f) < 1e-5 && fabsf(probs[1] - 0.5f) < 1e-5);
+		assert(HvGetDraculaProbability(hv, CASTLE_DRACULA) == 0.0f);
+		
+		HvApplyPlay(hv, "GGA....");
+		assert(fabsf(HvGetDraculaProbability(hv, KLAUSENBURG) - 1.0f) < 1e-5);
+		
+		// Probabilities over the possible places add up to 1, and places
+		// with more ways in from Klausenburg are more likely
+		HvApplyPlay(hv, "SGE....");
+		HvApplyPlay(hv, "HGE....");
+		HvApplyPlay(hv, "MGE....");
+		HvApplyPlay(hv, "DC?T...");
+		float total = 0.0f;
+		PlaceSet possible = HvGetDraculaPossibleLocations(hv);
+		for (PlaceId p = MIN_REAL_PLACE; p <= MAX_REAL_PLACE; p++) {
+			float prob = HvGetDraculaProbability(hv, p);
+			assert(prob >= 0.0f);
+			assert((prob > 0.0f) == placeSetContains(possible, p));
+			total += prob;
+		}
+		assert(fabsf(total - 1.0f) < 1e-5);
+		
+		int n = HvGetLikelyDraculaLocations(hv, 2, places, probs);
+		assert(n == 2 && probs[0] >= probs[1]);
+		for (PlaceId p = MIN_REAL_PLACE; p <= MAX_REAL_PLACE; p++) {
+			assert(HvGetDraculaProbability(hv, p) <= probs[0]);
+		}
+		
+		HvFree(hv);
+		printf("Test passed!\n");
+	}
+	
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Sampling Dracula's trail\n");
+		
+		char *trail =
+			"GGE.... SGE.... HGE.... MGE.... DCD.V.. "
+			"GGE.... SGE.... HGE.... MGE.... DC?T... "
+			"GGE.... SGE.... HGE.... MGE.... DD1T...";
+		
+		Message messages[15] = {};
+		HunterView hv = HvNew(trail, messages);
+		
+		// Every sample goes back to Castle Dracula through one of its
+		// neighbours, doubling back to it straight away
+		Random rng;
+		randomSeed(&rng, 2521);
+		bool seen[NUM_REAL_PLACES] = {};
+		for (int i = 0; i < 100; i++) {
+			PlaceId locations[TRAIL_SIZE];
+			assert(HvSampleDraculaTrail(hv, locations, &rng) == 3);
+			assert(locations[0] == GALATZ || locations[0] == KLAUSENBURG);
+			assert(locations[1] == locations[0]);
+			assert(locations[2] == CASTLE_DRACULA);
+			seen[locations[0]] = true;
+		}
+		assert(seen[GALATZ] && seen[KLAUSENBURG]);
+		
+		// Filling a sample into a copy of the game reveals Dracula,
+		// along with the traps he left on the way
+		GameView gv = GvNew(trail, messages);
+		PlaceId locations[TRAIL_SIZE] = {KLAUSENBURG, KLAUSENBURG,
+		                                 CASTLE_DRACULA};
+		GvDeterminise(gv, locations, 3);
+		assert(GvGetPlayerLocation(gv, PLAYER_DRACULA) == KLAUSENBURG);
+		int numTraps = -1;
+		PlaceId *traps = GvGetTrapLocations(gv, &numTraps);
+		assert(numTraps == 2);
+		sortPlaces(traps, numTraps);
+		assert(traps[0] == KLAUSENBURG && traps[1] == KLAUSENBURG);
+		free(traps);
+		GvFree(gv);
+		
+		// A hunter can run into a trap in a city the hunters haven't
+		// seen yet, after Dracula has moved on
+		HvApplyPlay(hv, "GGE....");
+		HvApplyPlay(hv, "SGE....");
+		HvApplyPlay(hv, "HGE....");
+		HvApplyPlay(hv, "MGE....");
+		HvApplyPlay(hv, "DC?T...");
+		HvApplyPlay(hv, "GKLT...");
+		assert(HvGetHealth(hv, PLAYER_LORD_GODALMING) ==
+		       GAME_START_HUNTER_LIFE_POINTS - LIFE_LOSS_TRAP_ENCOUNTER);
+		PlaceSet possible = HvGetDraculaPossibleLocations(hv);
+		assert(!placeSetIsEmpty(possible));
+		assert(!placeSetContains(possible, KLAUSENBURG));
+		
+		HvFree(hv);
+		printf("Test passed!\n");
+	}
+	
 	return EXIT_SUCCESS;
 }
-
@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// testRandom.c: test the random number generator
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Places.h"
+#include "Random.h"
+
+int main(void)
+{
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("The same seed gives the same numbers\n");
+		
+		Random a, b, c;
+		randomSeed(&a, 2521);
+		randomSeed(&b, 2521);
+		randomSeed(&c, 2522);
+		int numSame = 0;
+		for (int i = 0; i < 1000; i++) {
+			uint32_t x = randomNext(&a);
+			assert(x == randomNext(&b));
+			if (x == randomNext(&c)) numSame++;
+		}
+		assert(numSame < 5);
+		
+		// Copying the state forks the sequence
+		Random d = a;
+		assert(randomNext(&a) == randomNext(&d));
+		
+		printf("Test passed!\n");
+	}
+	
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Bounded numbers are in range and evenly spread\n");
+		
+		Random rng;
+		randomSeed(&rng, 1);
+		assert(randomBelow(&rng, 1) == 0);
+		
+		int counts[NUM_REAL_PLACES] = {};
+		int numDraws = 1000 * NUM_REAL_PLACES;
+		for (int i = 0; i < numDraws; i++) {
+			uint32_t x = randomBelow(&rng, NUM_REAL_PLACES);
+			assert(x < NUM_REAL_PLACES);
+			counts[x]++;
+		}
+		for (int i = 0; i < NUM_REAL_PLACES; i++) {
+			assert(counts[i] > 850 && counts[i] < 1150);
+		}
+		
+		// Bounds near the top of the range, where rejection matters
+		uint32_t big = UINT32_C(3) << 30;
+		int numHigh = 0;
+		for (int i = 0; i < 10000; i++) {
+			uint32_t x = randomBelow(&rng, big);
+			assert(x < big);
+			if (x >= big / 2) numHigh++;
+		}
+		assert(numHigh > 4700 && numHigh < 5300);
+		
+		double total = 0;
+		for (int i = 0; i < 10000; i++) {
+			double u = randomUnit(&rng);
+			assert(u >= 0.0 && u < 1.0);
+			total += u;
+		}
+		assert(total > 4800 && total < 5200);
+		
+		printf("Test passed!\n");
+	}
+	
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Shuffling gives a permutation\n");
+		
+		Random rng;
+		randomSeed(&rng, 7);
+		PlaceId places[NUM_REAL_PLACES];
+		for (int i = 0; i < NUM_REAL_PLACES; i++) places[i] = i;
+		randomShuffle(&rng, places, NUM_REAL_PLACES);
+		
+		bool seen[NUM_REAL_PLACES] = {};
+		int numMoved = 0;
+		for (int i = 0; i < NUM_REAL_PLACES; i++) {
+			assert(placeIsReal(places[i]) && !seen[places[i]]);
+			seen[places[i]] = true;
+			if (places[i] != i) numMoved++;
+		}
+		assert(numMoved > NUM_REAL_PLACES / 2);
+		
+		// Each place ends up first about as often as any other
+		int first[4] = {};
+		for (int i = 0; i < 4000; i++) {
+			PlaceId small[4] = { 0, 1, 2, 3 };
+			randomShuffle(&rng, small, 4);
+			first[small[0]]++;
+		}
+		for (int i = 0; i < 4; i++) {
+			assert(first[i] > 850 && first[i] < 1150);
+		}
+		
+		// Nothing to do for short arrays
+		PlaceId one[1] = { GALATZ };
+		randomShuffle(&rng, one, 1);
+		randomShuffle(&rng, one, 0);
+		assert(one[0] == GALATZ);
+		
+		printf("Test passed!\n");
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// testReplay.c: test the Replay ADT
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "Game.h"
+#include "Replay.h"
+
+#define TEST_FILE "testReplay.replay"
+
+int main(void)
+{
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Writing and reading back a replay\n");
+		
+		char *plays =
+			"GMN.... SGA.... HFR.... MMA.... DCD.V.. "
+			"GED.... SCD.... HMU.... MAL.... DD1T...";
+		ReplayReveal reveals[] = {
+			{ .shown = "C?", .revealedAt = 7 },
+			{ .shown = "D1", .revealedAt = REPLAY_NEVER },
+		};
+		
+		ReplayWriter rw = ReplayWriterNew(TEST_FILE);
+		ReplayWriterAddGame(rw, "", NULL, GAME_START_SCORE, 0);
+		ReplayWriterAddGame(rw, plays, reveals, 354, 2);
+		ReplayWriterFree(rw);
+		
+		Replay rp = ReplayOpen(TEST_FILE);
+		assert(rp != NULL);
+		assert(ReplayNumGames(rp) == 2);
+		assert(ReplayNumPlays(rp, 0) == 0);
+		assert(ReplayNumPlays(rp, 1) == 10);
+		assert(ReplayFinalScore(rp, 1) == 354);
+		assert(ReplayFinalRound(rp, 1) == 2);
+		assert(strncmp(ReplayGetPlay(rp, 1, 4), "DCD.V..", 7) == 0);
+		
+		char pastPlays[10 * REPLAY_RECORD_SIZE + 1];
+		ReplayGetPastPlays(rp, 0, 0, pastPlays);
+		assert(strcmp(pastPlays, "") == 0);
+		
+		// The hunters don't know where Dracula went until play 7...
+		ReplayGetPastPlays(rp, 1, 6, pastPlays);
+		assert(strcmp(pastPlays,
+			"GMN.... SGA.... HFR.... MMA.... DC?.V.. GED....") == 0);
+		
+		// ...but he always does
+		ReplayGetPastPlays(rp, 1, 9, pastPlays);
+		assert(strncmp(pastPlays, plays, strlen(pastPlays)) == 0);
+		assert(strlen(pastPlays) == 9 * REPLAY_RECORD_SIZE - 1);
+		
+		ReplayGetPastPlays(rp, 1, 10, pastPlays);
+		assert(strcmp(pastPlays, plays) == 0);
+		
+		ReplayClose(rp);
+		unlink(TEST_FILE);
+		printf("Test passed!\n");
+	}
+	
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Not reading something that isn't a replay\n");
+		
+		assert(ReplayOpen("no such file") == NULL);
+		assert(ReplayOpen("testReplay.c") == NULL);
+		
+		// A replay claiming more games than it has room for
+		ReplayWriter rw = ReplayWriterNew(TEST_FILE);
+		ReplayWriterAddGame(rw, "", NULL, GAME_START_SCORE, 0);
+		ReplayWriterFree(rw);
+		FILE *file = fopen(TEST_FILE, "r+b");
+		assert(file != NULL);
+		unsigned char numGames[4] = { 0xFF, 0xFF, 0xFF, 0xFF };
+		fseek(file, 12, SEEK_SET);
+		fwrite(numGames, 1, sizeof(numGames), file);
+		fclose(file);
+		assert(ReplayOpen(TEST_FILE) == NULL);
+		unlink(TEST_FILE);
+		
+		printf("Test passed!\n");
+	}
+	
+	return EXIT_SUCCESS;
+}
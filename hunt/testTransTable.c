@@ -0,0 +1,59 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// testTransTable.c: test the TransTable ADT
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Places.h"
+#include "TransTable.h"
+
+int main(void)
+{
+	{///////////////////////////////////////////////////////////////////
+	
+		printf("Storing and probing entries\n");
+		
+		TransTable tt = TransTableNew(4);
+		TtEntry entry = { .value = 0, .depth = 0, .move = NOWHERE };
+		assert(!TransTableProbe(tt, 0x1234, &entry));
+		
+		TransTableStore(tt, 0x1234, (TtEntry) {
+			.value = -42, .depth = 3, .move = HIDE, .bound = TT_LOWER
+		});
+		assert(TransTableProbe(tt, 0x1234, &entry));
+		assert(entry.value == -42);
+		assert(entry.depth == 3);
+		assert(entry.move == HIDE);
+		assert(entry.bound == TT_LOWER);
+		
+		// A shallower search doesn't overwrite a deeper one
+		TransTableStore(tt, 0x1234, (TtEntry) {
+			.value = 7, .depth = 1, .move = NOWHERE, .bound = TT_EXACT
+		});
+		assert(TransTableProbe(tt, 0x1234, &entry));
+		assert(entry.value == -42);
+		
+		// A different position in the same bucket doesn't evict it
+		TransTableStore(tt, 0x1234 + 8, (TtEntry) {
+			.value = 7, .depth = 1, .move = NOWHERE, .bound = TT_EXACT
+		});
+		assert(TransTableProbe(tt, 0x1234, &entry));
+		assert(TransTableProbe(tt, 0x1234 + 8, &entry));
+		assert(entry.value == 7);
+		assert(entry.move == NOWHERE);
+		
+		TransTableClear(tt);
+		assert(!TransTableProbe(tt, 0x1234, &entry));
+		
+		TransTableFree(tt);
+		printf("Test passed!\n");
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,347 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// tournament.c: play lots of games with the referee, and sum them up
+//
+// Runs ./referee once per game, several games at a time. Each job takes
+// the next game off a shared queue as soon as it's free, so a long game
+// doesn't hold the others up. Each game gets its own seed (the first
+// game gets the -s seed, the next gets seed + 1, and so on). With -i,
+// every search runs a fixed number of iterations, so a bad game can be
+// played again with `./referee -s seed -i iterations -v`; without it,
+// the searches stop on the clock and a game won't replay exactly.
+//
+// Usage: ./tournament [-n games] [-j jobs] [-s seed] [-t msecs]
+//                     [-i iterations] [-r referee] [-d dracula]
+//                     [-h hunter] [-o file.csv]
+//     -n games    how many games to play (default 100)
+//     -j jobs     how many games to play at once (default: one per core)
+//     -s seed     the first game's seed (default: from the time)
+//     -t msecs    the time allowed per turn (default 10)
+//     -i n        run each search for n iterations instead of stopping
+//                 on the clock (passed on as FOD_ITERATIONS)
+//     -r referee  the referee to run (default ./referee)
+//     -d dracula  passed on to the referee: a Dracula player to run
+//     -h hunter   passed on to the referee: a hunter player to run
+//     -o file     write one line per game to file, as CSV
+//
+// The referee plays whichever Dracula and hunter it links, unless it's
+// given players to run instead. So to try a new Dracula against the
+// current hunters, either of these will do:
+//     make referee DRACULA_AI=draculaNew.o && mv referee refereeNew
+//     ./tournament -r ./refereeNew
+// or
+//     cp dracula draculaOld && (edit dracula.c) && make dracula
+//     ./tournament -d ./dracula
+//
+// Each game's searches run on one thread (FOD_THREADS=1) unless
+// FOD_THREADS is already set, since the games already use every core.
+//
+// The referee, Dracula and hunter paths are quoted for the shell, so
+// they can have spaces or other special characters in them.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <math.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DEFAULT_NUM_GAMES   100
+#define DEFAULT_TURN_MSECS  10
+#define DEFAULT_REFEREE     "./referee"
+
+#define MAX_JOBS            256
+#define MAX_COMMAND         1024
+#define MAX_LINE            8192
+
+// For 95% confidence intervals
+#define Z_95                1.96
+
+typedef struct gameResult {
+	unsigned int seed;
+	bool         finished;  // whether the referee got to the end
+	int          score;
+	int          round;
+	int          health;    // Dracula's, at the end
+	double       msecs;
+} GameResult;
+
+typedef struct tournament {
+	char         referee[MAX_COMMAND];  // quoted for the shell
+	char         players[MAX_COMMAND];  // -d and -h, for the referee
+	int          turnMsecs;
+	unsigned int firstSeed;
+	int          numGames;
+	int          nextGame;  // the front of the queue
+	GameResult  *results;
+} Tournament;
+
+static bool quoteArg(char *to, size_t size, const char *arg);
+static void *runJob(void *arg);
+static void playGame(Tournament *t, int game);
+static double nowMsecs(void);
+static void writeCsv(Tournament *t, const char *filename);
+static void showSummary(Tournament *t, int numJobs, double msecs);
+static int compareInts(const void *a, const void *b);
+
+int main(int argc, char *argv[])
+{
+	Tournament t = {
+		.referee = DEFAULT_REFEREE,
+		.turnMsecs = DEFAULT_TURN_MSECS,
+		.firstSeed = (unsigned int) time(NULL),
+		.numGames = DEFAULT_NUM_GAMES,
+		.nextGame = 0,
+	};
+	long cores = sysconf(_SC_NPROCESSORS_ONLN);
+	int numJobs = (cores > 0) ? (int) cores : 1;
+	const char *csvFile = NULL;
+
+	int opt;
+	size_t len;
+	while ((opt = getopt(argc, argv, "n:j:s:t:i:r:d:h:o:")) != -1) {
+		switch (opt) {
+			case 'n': t.numGames = atoi(optarg);                  break;
+			case 'j': numJobs = atoi(optarg);                     break;
+			case 's': t.firstSeed = strtoul(optarg, NULL, 10);    break;
+			case 't': t.turnMsecs = atoi(optarg);                 break;
+			case 'i': setenv("FOD_ITERATIONS", optarg, 1);       break;
+			case 'r':
+				if (!quoteArg(t.referee, MAX_COMMAND, optarg)) {
+					fprintf(stderr, "Referee path too long\n");
+					exit(EXIT_FAILURE);
+				}
+				break;
+			case 'd':
+			case 'h':
+				len = strlen(t.players);
+				if (len + 4 >= MAX_COMMAND) {
+					fprintf(stderr, "Too many players\n");
+					exit(EXIT_FAILURE);
+				}
+				snprintf(t.players + len, MAX_COMMAND - len, " -%c ", opt);
+				len += 4;
+				if (!quoteArg(t.players + len, MAX_COMMAND - len, optarg)) {
+					fprintf(stderr, "Too many players\n");
+					exit(EXIT_FAILURE);
+				}
+				break;
+			case 'o': csvFile = optarg;                           break;
+			default:
+				fprintf(stderr, "usage: %s [-n games] [-j jobs] [-s seed] "
+				        "[-t msecs] [-i iterations] [-r referee] "
+				        "[-d dracula] [-h hunter] [-o file.csv]\n", argv[0]);
+				exit(EXIT_FAILURE);
+		}
+	}
+	if (t.numGames < 1) t.numGames = 1;
+	if (numJobs < 1) numJobs = 1;
+	if (numJobs > MAX_JOBS) numJobs = MAX_JOBS;
+	if (numJobs > t.numGames) numJobs = t.numGames;
+
+	t.results = calloc(t.numGames, sizeof(GameResult));
+	if (t.results == NULL) {
+		fprintf(stderr, "Couldn't allocate results\n");
+		exit(EXIT_FAILURE);
+	}
+	setenv("FOD_THREADS", "1", 0);
+
+	double start = nowMsecs();
+	pthread_t jobs[MAX_JOBS];
+	for (int i = 0; i < numJobs; i++) {
+		if (pthread_create(&jobs[i], NULL, runJob, &t) != 0) {
+			fprintf(stderr, "Couldn't start job %d\n", i);
+			exit(EXIT_FAILURE);
+		}
+	}
+	for (int i = 0; i < numJobs; i++) {
+		pthread_join(jobs[i], NULL);
+	}
+	double msecs = nowMsecs() - start;
+
+	if (csvFile != NULL) writeCsv(&t, csvFile);
+	showSummary(&t, numJobs, msecs);
+
+	free(t.results);
+	return EXIT_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Playing the games
+
+/**
+ * Writes the given argument in single quotes, so the shell passes it on
+ * as it is. Returns false if it doesn't fit in `size` bytes.
+ */
+static bool quoteArg(char *to, size_t size, const char *arg) {
+	size_t n = 0;
+	if (n + 1 >= size) return false;
+	to[n++] = '\'';
+	for (const char *c = arg; *c != '\0'; c++) {
+		// A quote ends the quoted part, adds an escaped quote, and
+		// starts a new quoted part
+		const char *part = (*c == '\'') ? "'\\''" : NULL;
+		size_t partLen = (part != NULL) ? strlen(part) : 1;
+		if (n + partLen >= size) return false;
+		if (part != NULL) {
+			memcpy(to + n, part, partLen);
+		} else {
+			to[n] = *c;
+		}
+		n += partLen;
+	}
+	if (n + 1 >= size) return false;
+	to[n++] = '\'';
+	to[n] = '\0';
+	return true;
+}
+
+/**
+ * Plays games off the queue until there are none left
+ */
+static void *runJob(void *arg) {
+	Tournament *t = arg;
+	while (true) {
+		int game = __atomic_fetch_add(&t->nextGame, 1, __ATOMIC_RELAXED);
+		if (game >= t->numGames) break;
+		playGame(t, game);
+	}
+	return NULL;
+}
+
+/**
+ * Runs the referee for one game, and reads the result from the end of
+ * what it prints
+ */
+static void playGame(Tournament *t, int game) {
+	GameResult *result = &t->results[game];
+	result->seed = t->firstSeed + (unsigned int) game;
+
+	char command[MAX_COMMAND];
+	int len = snprintf(command, MAX_COMMAND, "%s -t %d -s %u%s 2>/dev/null",
+	                   t->referee, t->turnMsecs, result->seed, t->players);
+	if (len < 0 || len >= MAX_COMMAND) {
+		fprintf(stderr, "Game %d (seed %u): the referee command is too "
+		        "long\n", game, result->seed);
+		return;
+	}
+
+	double start = nowMsecs();
+	FILE *out = popen(command, "r");
+	if (out == NULL) {
+		fprintf(stderr, "Couldn't run '%s'\n", command);
+		return;
+	}
+
+	bool gotScore = false;
+	bool gotRound = false;
+	char line[MAX_LINE];
+	while (fgets(line, MAX_LINE, out) != NULL) {
+		gotScore = gotScore
+		        || sscanf(line, "Final score: %d", &result->score) == 1;
+		gotRound = gotRound
+		        || sscanf(line, "Final round: %d", &result->round) == 1;
+		sscanf(line, "  health: %d", &result->health);
+	}
+	int status = pclose(out);
+	result->msecs = nowMsecs() - start;
+	result->finished = status == 0 && gotScore && gotRound;
+
+	if (!result->finished) {
+		fprintf(stderr, "Game %d (seed %u) didn't finish (status %d)\n",
+		        game, result->seed, status);
+	}
+}
+
+static double nowMsecs(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec * 1000.0 + now.tv_nsec / 1000000.0;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Results
+
+static void writeCsv(Tournament *t, const char *filename) {
+	FILE *csv = fopen(filename, "w");
+	if (csv == NULL) {
+		fprintf(stderr, "Couldn't open '%s'\n", filename);
+		return;
+	}
+
+	fprintf(csv, "game,seed,finished,score,round,health,msecs\n");
+	for (int i = 0; i < t->numGames; i++) {
+		GameResult *r = &t->results[i];
+		fprintf(csv, "%d,%u,%d,%d,%d,%d,%.0f\n", i, r->seed, r->finished,
+		        r->score, r->round, r->health, r->msecs);
+	}
+	fclose(csv);
+}
+
+/**
+ * Shows the mean and median score, with a 95% confidence interval for
+ * the mean, how often Dracula survived, and how fast the games went.
+ * Games the referee didn't finish are left out.
+ */
+static void showSummary(Tournament *t, int numJobs, double msecs) {
+	int *scores = malloc(t->numGames * sizeof(int));
+	if (scores == NULL) {
+		fprintf(stderr, "Couldn't allocate scores\n");
+		exit(EXIT_FAILURE);
+	}
+
+	int n = 0;
+	int numSurvived = 0;
+	double totalScore = 0.0;
+	double totalRounds = 0.0;
+	for (int i = 0; i < t->numGames; i++) {
+		GameResult *r = &t->results[i];
+		if (!r->finished) continue;
+		scores[n++] = r->score;
+		totalScore += r->score;
+		totalRounds += r->round;
+		if (r->health > 0) numSurvived++;
+	}
+
+	printf("Games:            %d (%d didn't finish)\n",
+	       t->numGames, t->numGames - n);
+	if (n == 0) {
+		free(scores);
+		return;
+	}
+
+	double mean = totalScore / n;
+	double variance = 0.0;
+	for (int i = 0; i < n; i++) {
+		variance += (scores[i] - mean) * (scores[i] - mean);
+	}
+	variance = (n > 1) ? variance / (n - 1) : 0.0;
+	double scoreError = Z_95 * sqrt(variance / n);
+
+	qsort(scores, n, sizeof(int), compareInts);
+	double median = (n % 2 == 1) ? scores[n / 2]
+	              : (scores[n / 2 - 1] + scores[n / 2]) / 2.0;
+
+	double survival = (double) numSurvived / n;
+	double survivalError = Z_95 * sqrt(survival * (1 - survival) / n);
+
+	printf("Score:            mean %.1f +/- %.1f (95%% CI), median %.1f, "
+	       "range %d..%d\n", mean, scoreError, median, scores[0], scores[n - 1]);
+	printf("Final round:      mean %.1f\n", totalRounds / n);
+	printf("Dracula survived: %.1f%% +/- %.1f%% (95%% CI)\n",
+	       100 * survival, 100 * survivalError);
+	printf("Speed:            %.2f games/sec (%d jobs, %.1f s)\n",
+	       t->numGames / (msecs / 1000), numJobs, msecs / 1000);
+
+	free(scores);
+}
+
+static int compareInts(const void *a, const void *b) {
+	int x = *(const int *) a;
+	int y = *(const int *) b;
+	return (x > y) - (x < y);
+}
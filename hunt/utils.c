@@ -4,6 +4,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "Arena.h"
+#include "PlaceSet.h"
 #include "Places.h"
 #include "utils.h"
 
@@ -11,8 +13,7 @@
  * Extracts places whose corresponding index in bools is true
  */
 PlaceId *boolsToPlaces(bool bools[NUM_REAL_PLACES], int *numPlaces) {
-	PlaceId *locations = malloc(NUM_REAL_PLACES * sizeof(PlaceId));
-	assert(locations != NULL);
+	PlaceId *locations = ArenaAllocResult(NUM_REAL_PLACES * sizeof(PlaceId));
 	
 	*numPlaces = 0;
 	for (int i = 0; i < NUM_REAL_PLACES; i++) {
@@ -23,6 +24,16 @@ PlaceId *boolsToPlaces(bool bools[NUM_REAL_PLACES], int *numPlaces) {
 	return locations;
 }
 
+/**
+ * Copies the places in a set into a new array
+ */
+PlaceId *placeSetToPlaces(PlaceSet set, int *numPlaces) {
+	PlaceId *locations = ArenaAllocResult(NUM_REAL_PLACES * sizeof(PlaceId));
+	
+	*numPlaces = placeSetToArray(set, locations);
+	return locations;
+}
+
 bool placesContains(PlaceId *places, int numPlaces, PlaceId place) {
 	for (int i = 0; i < numPlaces; i++) {
 		if (places[i] == place) {
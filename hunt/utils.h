@@ -2,6 +2,7 @@
 #include <stdbool.h>
 #include <stdlib.h>
 
+#include "PlaceSet.h"
 #include "Places.h"
 
 #ifndef FOD__UTILS_H_
@@ -16,6 +17,11 @@
  */
 PlaceId *boolsToPlaces(bool bools[NUM_REAL_PLACES], int *numPlaces);
 
+/**
+ * Copies the places in a set into a new array (in increasing order)
+ */
+PlaceId *placeSetToPlaces(PlaceSet set, int *numPlaces);
+
 bool placesContains(PlaceId *places, int numPlaces, PlaceId place);
 
 /**
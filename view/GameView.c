@@ -211,8 +211,10 @@ PlaceId *GvGetMoveHistory(GameView gv, Player player,
 	// error handling
 	assert(playerName != '\0');
 
-	// Dynamically allocate array of PlaceIds
-	PlaceId *pastMoves = malloc(sizeof(PlaceId *) * MAX_REAL_PLACE);
+	// Dynamically allocate array of PlaceIds, one for each round
+	// (games can go on for more rounds than there are places)
+	int numRounds = (strlen(gv->pastPlays) + 1) / 8 / NUM_PLAYERS + 1;
+	PlaceId *pastMoves = malloc(sizeof(PlaceId) * numRounds);
 
 	// Fill in PlaceId array with move history of given player.
 	// Loop through pastPlays string...
@@ -286,11 +288,12 @@ PlaceId *GvGetLocationHistory(GameView gv, Player player,
 	} 
 
 	// For Dracula:
-	PlaceId *pastLocs = malloc(sizeof(PlaceId) * MAX_REAL_PLACE);
+	// one for each move (games can go on for more rounds than there
+	// are places)
+	PlaceId *pastLocs = malloc(sizeof(PlaceId) * (*numReturnedLocs + 1));
 	assert(pastLocs != NULL);
 	int i = 0;
 
-	// might be bug if i + 6 exceeds array index.
 	while (i < *numReturnedLocs) 
 	{
 		PlaceId location = pastMoves[i];
@@ -0,0 +1,421 @@
+////////////////////////////////////////////////////////////////////////
+// COMP2521 20T2 ... the Fury of Dracula
+// benchScaling.c: time the view functions against the length of a game
+//
+// The same benchmark as hunt/benchScaling.c, for the views in this
+// directory, on the states it writes: for each length of game, one of
+// Dracula's turns and the hunters' turn after it. Make them and run
+// this with `make bench`, or
+//
+//     (cd ../hunt && make scaling.txt)
+//     ./benchScaling [-c results.csv] ../hunt/scaling.txt
+//
+// The report has a table each for the time, allocations and bytes
+// allocated per call, and a growth column: how the figure for the
+// longest game compares to the one for a fifth as long, as a power of
+// the length (about 0 for constant, 1 for linear, 2 for quadratic).
+// With -c, the results are also written as
+//     impl,function,rounds,ns_per_op,allocs_per_op,bytes_per_op
+// in the same form as hunt/benchScaling's, so the two can be plotted
+// together.
+//
+// How long each function runs for at each length is read from the
+// environment:
+//     FOD_BENCH_MSECS  how long to run each function for (200)
+//
+////////////////////////////////////////////////////////////////////////
+
+#define _GNU_SOURCE
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "DraculaView.h"
+#include "Game.h"
+#include "GameView.h"
+#include "HunterView.h"
+#include "Places.h"
+
+#define DEFAULT_BENCH_MSECS 200
+#define MAX_LENGTHS         16
+
+// How long a batch of calls should take, and the most calls in one
+#define BATCH_NSECS         1000.0
+#define MAX_BATCH           1024
+
+// Everything the functions run on, at one length
+typedef struct length {
+	int         rounds;
+	char       *draculaPlays; // Dracula's turn in the last round
+	char       *hunterPlays;  // Lord Godalming's turn after it
+	Message    *messages;     // blank, as these views copy them
+	GameView    gv;
+	HunterView  hv;
+	DraculaView dv;
+} Length;
+
+typedef void (*BenchOp)(Length *l);
+
+typedef struct function {
+	const char *name;
+	BenchOp     op;
+} Function;
+
+typedef struct result {
+	double nsecsPerOp;
+	double allocsPerOp;
+	double bytesPerOp;
+} Result;
+
+static long numAllocs = 0;
+static long numBytes = 0;
+
+static int readLengths(const char *file, Length ls[]);
+static void measure(BenchOp op, Length *l, int benchMsecs, Result *r);
+static double nowNsecs(void);
+static void showTable(const char *title, Result results[][MAX_LENGTHS],
+                      Length ls[], int numLengths, int metric);
+static double metricOf(Result *r, int metric);
+
+static void benchGvNew(Length *l);
+static void benchGvGetMoveHistory(Length *l);
+static void benchGvGetLocationHistory(Length *l);
+static void benchGvGetLastMoves(Length *l);
+static void benchGvGetTrapLocations(Length *l);
+static void benchGvGetReachableByType(Length *l);
+static void benchHvNew(Length *l);
+static void benchHvGetLastKnownDraculaLocation(Length *l);
+static void benchHvGetShortestPathTo(Length *l);
+static void benchDvNew(Length *l);
+static void benchDvGetValidMoves(Length *l);
+static void benchDvWhereCanTheyGoByType(Length *l);
+
+static Function functions[] = {
+	{ "GvNew",                         benchGvNew },
+	{ "GvGetMoveHistory",              benchGvGetMoveHistory },
+	{ "GvGetLocationHistory",          benchGvGetLocationHistory },
+	{ "GvGetLastMoves",                benchGvGetLastMoves },
+	{ "GvGetTrapLocations",            benchGvGetTrapLocations },
+	{ "GvGetReachableByType",          benchGvGetReachableByType },
+	{ "HvNew",                         benchHvNew },
+	{ "HvGetLastKnownDraculaLocation", benchHvGetLastKnownDraculaLocation },
+	{ "HvGetShortestPathTo",           benchHvGetShortestPathTo },
+	{ "DvNew",                         benchDvNew },
+	{ "DvGetValidMoves",               benchDvGetValidMoves },
+	{ "DvWhereCanTheyGoByType",        benchDvWhereCanTheyGoByType },
+};
+#define NUM_FUNCTIONS ((int) (sizeof(functions) / sizeof(functions[0])))
+
+// What the tables show
+#define NSECS  0
+#define ALLOCS 1
+#define BYTES  2
+
+int main(int argc, char *argv[])
+{
+	const char *csvFile = NULL;
+	int opt;
+	while ((opt = getopt(argc, argv, "c:")) != -1) {
+		switch (opt) {
+			case 'c': csvFile = optarg; break;
+			default:
+				fprintf(stderr, "usage: %s [-c results.csv] states.txt\n",
+				        argv[0]);
+				exit(EXIT_FAILURE);
+		}
+	}
+	if (optind >= argc) {
+		fprintf(stderr, "usage: %s [-c results.csv] states.txt\n", argv[0]);
+		exit(EXIT_FAILURE);
+	}
+	
+	int benchMsecs = DEFAULT_BENCH_MSECS;
+	const char *value = getenv("FOD_BENCH_MSECS");
+	if (value != NULL && atoi(value) > 0) benchMsecs = atoi(value);
+	
+	Length ls[MAX_LENGTHS] = {};
+	int numLengths = readLengths(argv[optind], ls);
+	for (int i = 0; i < numLengths; i++) {
+		ls[i].messages = calloc(ls[i].rounds * NUM_PLAYERS, sizeof(Message));
+		if (ls[i].messages == NULL) {
+			fprintf(stderr, "Couldn't allocate messages\n");
+			exit(EXIT_FAILURE);
+		}
+		ls[i].gv = GvNew(ls[i].draculaPlays, ls[i].messages);
+		ls[i].hv = HvNew(ls[i].hunterPlays, ls[i].messages);
+		ls[i].dv = DvNew(ls[i].draculaPlays, ls[i].messages);
+	}
+	
+	static Result results[NUM_FUNCTIONS][MAX_LENGTHS];
+	for (int f = 0; f < NUM_FUNCTIONS; f++) {
+		for (int i = 0; i < numLengths; i++) {
+			measure(functions[f].op, &ls[i], benchMsecs, &results[f][i]);
+		}
+	}
+	showTable("ns/op", results, ls, numLengths, NSECS);
+	showTable("allocs/op", results, ls, numLengths, ALLOCS);
+	showTable("bytes/op", results, ls, numLengths, BYTES);
+	
+	if (csvFile != NULL) {
+		FILE *out = fopen(csvFile, "w");
+		if (out == NULL) {
+			fprintf(stderr, "Couldn't open '%s'\n", csvFile);
+			exit(EXIT_FAILURE);
+		}
+		fprintf(out, "impl,function,rounds,ns_per_op,allocs_per_op,"
+		        "bytes_per_op\n");
+		for (int f = 0; f < NUM_FUNCTIONS; f++) {
+			for (int i = 0; i < numLengths; i++) {
+				Result *r = &results[f][i];
+				fprintf(out, "view,%s,%d,%.1f,%.2f,%.0f\n", functions[f].name,
+				        ls[i].rounds, r->nsecsPerOp, r->allocsPerOp,
+				        r->bytesPerOp);
+			}
+		}
+		fclose(out);
+	}
+	
+	for (int i = 0; i < numLengths; i++) {
+		GvFree(ls[i].gv);
+		HvFree(ls[i].hv);
+		DvFree(ls[i].dv);
+		free(ls[i].draculaPlays);
+		free(ls[i].hunterPlays);
+		free(ls[i].messages);
+	}
+	return EXIT_SUCCESS;
+}
+
+/**
+ * Reads the states: a Dracula's turn and a hunters' turn for each
+ * length, one pastPlays string per line
+ */
+static int readLengths(const char *file, Length ls[]) {
+	FILE *in = fopen(file, "r");
+	if (in == NULL) {
+		fprintf(stderr, "Couldn't open '%s'\n", file);
+		exit(EXIT_FAILURE);
+	}
+	
+	int numLengths = 0;
+	char *line = NULL;
+	size_t size = 0;
+	while (getline(&line, &size, in) != -1) {
+		line[strcspn(line, "\r\n")] = '\0';
+		int numPlays = (strlen(line) + 1) / 8;
+		if (numPlays == 0) continue;
+		
+		if (numPlays % NUM_PLAYERS == PLAYER_DRACULA) {
+			if (numLengths == MAX_LENGTHS) break;
+			ls[numLengths].rounds = (numPlays + 1) / NUM_PLAYERS;
+			ls[numLengths].draculaPlays = strdup(line);
+			ls[numLengths].hunterPlays = NULL;
+		} else if (numPlays % NUM_PLAYERS == PLAYER_LORD_GODALMING
+		        && numLengths < MAX_LENGTHS
+		        && ls[numLengths].hunterPlays == NULL
+		        && numPlays / NUM_PLAYERS == ls[numLengths].rounds) {
+			ls[numLengths].hunterPlays = strdup(line);
+			numLengths++;
+		}
+	}
+	free(line);
+	fclose(in);
+	
+	if (numLengths == 0) {
+		fprintf(stderr, "No states in '%s'\n", file);
+		exit(EXIT_FAILURE);
+	}
+	return numLengths;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Timing
+//
+// malloc, calloc and realloc are counted by standing in for the C
+// library's own, which they call.
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t num, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+void *malloc(size_t size) {
+	numAllocs++;
+	numBytes += size;
+	return __libc_malloc(size);
+}
+
+void *calloc(size_t num, size_t size) {
+	numAllocs++;
+	numBytes += num * size;
+	return __libc_calloc(num, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+	numAllocs++;
+	numBytes += size;
+	return __libc_realloc(ptr, size);
+}
+
+/**
+ * Runs op over and over in batches of about a microsecond, for
+ * benchMsecs, and fills in the time and allocations per call
+ */
+static void measure(BenchOp op, Length *l, int benchMsecs, Result *r) {
+	double start = nowNsecs();
+	op(l);
+	double warmupNsecs = nowNsecs() - start;
+	int batch = (int) ceil(BATCH_NSECS / fmax(warmupNsecs, 1.0));
+	if (batch > MAX_BATCH) batch = MAX_BATCH;
+	
+	long numCalls = 0;
+	long allocsBefore = numAllocs;
+	long bytesBefore = numBytes;
+	start = nowNsecs();
+	double deadline = start + benchMsecs * 1e6;
+	double now = start;
+	while (numCalls == 0 || now < deadline) {
+		for (int j = 0; j < batch; j++) {
+			op(l);
+		}
+		numCalls += batch;
+		now = nowNsecs();
+	}
+	
+	r->nsecsPerOp = (now - start) / numCalls;
+	r->allocsPerOp = (double) (numAllocs - allocsBefore) / numCalls;
+	r->bytesPerOp = (double) (numBytes - bytesBefore) / numCalls;
+}
+
+static double nowNsecs(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Reporting
+
+static void showTable(const char *title, Result results[][MAX_LENGTHS],
+                      Length ls[], int numLengths, int metric) {
+	printf("%-32s", title);
+	for (int i = 0; i < numLengths; i++) {
+		printf(" %10d", ls[i].rounds);
+	}
+	printf(" %8s\n", "growth");
+	
+	// Compares the longest game with the one nearest a fifth as long
+	int to = numLengths - 1;
+	int from = 0;
+	for (int i = 0; i < numLengths; i++) {
+		if (abs(ls[i].rounds * 5 - ls[to].rounds)
+		        < abs(ls[from].rounds * 5 - ls[to].rounds)) {
+			from = i;
+		}
+	}
+	
+	for (int f = 0; f < NUM_FUNCTIONS; f++) {
+		printf("%-32s", functions[f].name);
+		for (int i = 0; i < numLengths; i++) {
+			printf(" %10.*f", metric == ALLOCS ? 2 : metric == NSECS ? 1 : 0,
+			       metricOf(&results[f][i], metric));
+		}
+		double x = metricOf(&results[f][from], metric);
+		double y = metricOf(&results[f][to], metric);
+		double ratio = (double) ls[to].rounds / ls[from].rounds;
+		if (x > 0 && y > 0 && ratio > 1) {
+			printf(" %8.2f\n", log(y / x) / log(ratio));
+		} else {
+			printf(" %8s\n", "-");
+		}
+	}
+	printf("\n");
+	fflush(stdout);
+}
+
+static double metricOf(Result *r, int metric) {
+	switch (metric) {
+		case NSECS:  return r->nsecsPerOp;
+		case ALLOCS: return r->allocsPerOp;
+		default:     return r->bytesPerOp;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+// The benchmarks
+
+static void benchGvNew(Length *l) {
+	GvFree(GvNew(l->draculaPlays, l->messages));
+}
+
+static void benchGvGetMoveHistory(Length *l) {
+	int numMoves = 0;
+	bool canFree = false;
+	PlaceId *moves = GvGetMoveHistory(l->gv, PLAYER_DRACULA, &numMoves,
+	                                  &canFree);
+	if (canFree) free(moves);
+}
+
+static void benchGvGetLocationHistory(Length *l) {
+	int numLocs = 0;
+	bool canFree = false;
+	PlaceId *locs = GvGetLocationHistory(l->gv, PLAYER_DRACULA, &numLocs,
+	                                     &canFree);
+	if (canFree) free(locs);
+}
+
+static void benchGvGetLastMoves(Length *l) {
+	int numMoves = 0;
+	bool canFree = false;
+	PlaceId *moves = GvGetLastMoves(l->gv, PLAYER_DRACULA, TRAIL_SIZE,
+	                                &numMoves, &canFree);
+	if (canFree) free(moves);
+}
+
+static void benchGvGetTrapLocations(Length *l) {
+	int numTraps = 0;
+	free(GvGetTrapLocations(l->gv, &numTraps));
+}
+
+static void benchGvGetReachableByType(Length *l) {
+	PlaceId from = GvGetPlayerLocation(l->gv, PLAYER_LORD_GODALMING);
+	int numLocs = 0;
+	free(GvGetReachableByType(l->gv, PLAYER_LORD_GODALMING, l->rounds,
+	                          from, true, true, true, &numLocs));
+}
+
+static void benchHvNew(Length *l) {
+	HvFree(HvNew(l->hunterPlays, l->messages));
+}
+
+static void benchHvGetLastKnownDraculaLocation(Length *l) {
+	Round round = 0;
+	HvGetLastKnownDraculaLocation(l->hv, &round);
+}
+
+static void benchHvGetShortestPathTo(Length *l) {
+	static PlaceId dest = 0;
+	int pathLength = 0;
+	free(HvGetShortestPathTo(l->hv, PLAYER_LORD_GODALMING, dest,
+	                         &pathLength));
+	dest = (dest + 1) % NUM_REAL_PLACES;
+}
+
+static void benchDvNew(Length *l) {
+	DvFree(DvNew(l->draculaPlays, l->messages));
+}
+
+static void benchDvGetValidMoves(Length *l) {
+	int numMoves = 0;
+	free(DvGetValidMoves(l->dv, &numMoves));
+}
+
+static void benchDvWhereCanTheyGoByType(Length *l) {
+	int numLocs = 0;
+	free(DvWhereCanTheyGoByType(l->dv, PLAYER_LORD_GODALMING,
+	                            true, true, true, &numLocs));
+}